@@ -0,0 +1,116 @@
+// Read throughput of tc_resource_map_mt versus tc_resource_map behind a
+// reader-writer lock, for 1..N reader threads while one writer churns.
+//
+//   cmake -DTERMIN_BASE_BUILD_BENCHMARKS=ON ...
+//   ./termin_base_bench_resource_map_mt [keys] [milliseconds]
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+#include <tcbase/tc_resource_map.h>
+#include <tcbase/tc_resource_map_mt.h>
+
+namespace {
+
+struct Keys {
+    std::vector<char> storage;
+    int count;
+
+    explicit Keys(int n) : storage((size_t)n * 37), count(n) {
+        for (int i = 0; i < n; i++) {
+            snprintf(at(i), 37, "%08x-0000-4000-8000-%012x", (unsigned)i * 2654435761u, (unsigned)i);
+        }
+    }
+    char* at(int i) { return storage.data() + (size_t)i * 37; }
+};
+
+struct LockedMap {
+    tc_resource_map* map;
+    std::shared_mutex lock;
+};
+
+// Runs readers for ms milliseconds while a writer adds/removes churn keys;
+// returns lookups per second
+template<typename Get, typename Churn>
+double run(int readers, int ms, Keys& keys, int stable, Get get, Churn churn) {
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> total{0};
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < readers; t++) {
+        threads.emplace_back([&, t] {
+            uint64_t n = 0;
+            unsigned x = (unsigned)t * 7919u + 1;
+            while (!stop.load(std::memory_order_relaxed)) {
+                for (int i = 0; i < 256; i++) {
+                    x = x * 1103515245u + 12345u;
+                    if (get(keys.at((int)(x % (unsigned)stable)))) n++;
+                }
+            }
+            total.fetch_add(n);
+        });
+    }
+    std::thread writer([&] {
+        int i = stable;
+        while (!stop.load(std::memory_order_relaxed)) {
+            churn(keys.at(i));
+            if (++i == keys.count) i = stable;
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+    stop = true;
+    for (std::thread& t : threads) t.join();
+    writer.join();
+    return (double)total.load() * 1000.0 / ms;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int stable = argc > 1 ? atoi(argv[1]) : 100000;
+    int ms = argc > 2 ? atoi(argv[2]) : 500;
+    int churn_keys = 1024;
+    int max_threads = (int)std::thread::hardware_concurrency();
+    if (max_threads < 1) max_threads = 1;
+
+    Keys keys(stable + churn_keys);
+    static int value;
+
+    tc_resource_map_mt* mt = tc_resource_map_mt_new(nullptr);
+    LockedMap locked{tc_resource_map_new(nullptr), {}};
+    for (int i = 0; i < stable; i++) {
+        tc_resource_map_mt_add(mt, keys.at(i), &value);
+        tc_resource_map_add(locked.map, keys.at(i), &value);
+    }
+
+    printf("%d keys, %d ms per run, Mlookups/s\n", stable, ms);
+    printf("%8s %14s %14s\n", "readers", "map_mt", "map+rwlock");
+    for (int readers = 1; readers <= max_threads; readers *= 2) {
+        double a = run(readers, ms, keys, stable,
+            [&](const char* k) { return tc_resource_map_mt_get(mt, k) != nullptr; },
+            [&](const char* k) {
+                if (!tc_resource_map_mt_remove(mt, k)) tc_resource_map_mt_add(mt, k, &value);
+            });
+        double b = run(readers, ms, keys, stable,
+            [&](const char* k) {
+                std::shared_lock<std::shared_mutex> lock(locked.lock);
+                return tc_resource_map_get(locked.map, k) != nullptr;
+            },
+            [&](const char* k) {
+                std::unique_lock<std::shared_mutex> lock(locked.lock);
+                if (!tc_resource_map_remove(locked.map, k)) tc_resource_map_add(locked.map, k, &value);
+            });
+        printf("%8d %14.1f %14.1f\n", readers, a / 1e6, b / 1e6);
+    }
+
+    tc_resource_map_mt_free(mt);
+    tc_resource_map_free(locked.map);
+    return 0;
+}
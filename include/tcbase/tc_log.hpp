@@ -1,13 +1,149 @@
 #pragma once
 
 #include <tcbase/tc_log.h>
+#include <tcbase/tc_log_binary.h>
 #include <string>
+#include <string_view>
 #include <cstdio>
 #include <cstdarg>
+#include <cstring>
 #include <exception>
+#include <type_traits>
+#include <vector>
 
 namespace tc {
 
+// A format string that outlives any deferred record: only literals convert
+class LogFormat {
+public:
+    template<size_t N>
+    consteval LogFormat(const char (&s)[N]) : str_(s) {}
+
+    constexpr const char* c_str() const { return str_; }
+
+private:
+    const char* str_;
+};
+
+namespace detail {
+
+template<typename T>
+inline constexpr bool log_always_false = false;
+
+// tc_log_arg_type for an argument, after printf default promotions
+template<typename T>
+constexpr uint8_t log_arg_type() {
+    using D = std::remove_cv_t<std::remove_reference_t<T>>;
+    using P = std::decay_t<D>;
+    if constexpr (std::is_same_v<D, std::string> || std::is_same_v<D, std::string_view> ||
+                  std::is_same_v<P, const char*> || std::is_same_v<P, char*>) {
+        return TC_LOG_ARG_STR;
+    } else if constexpr (std::is_pointer_v<P> || std::is_null_pointer_v<P>) {
+        return TC_LOG_ARG_PTR;
+    } else if constexpr (std::is_enum_v<D>) {
+        return log_arg_type<std::underlying_type_t<D>>();
+    } else if constexpr (std::is_floating_point_v<D>) {
+        static_assert(!std::is_same_v<D, long double>, "long double is not supported by deferred logging");
+        return TC_LOG_ARG_DOUBLE;
+    } else if constexpr (std::is_integral_v<D>) {
+        using Promoted = decltype(+D{});
+        if constexpr (std::is_same_v<Promoted, int>) return TC_LOG_ARG_INT;
+        else if constexpr (std::is_same_v<Promoted, unsigned int>) return TC_LOG_ARG_UINT;
+        else if constexpr (std::is_same_v<Promoted, long>) return TC_LOG_ARG_LONG;
+        else if constexpr (std::is_same_v<Promoted, unsigned long>) return TC_LOG_ARG_ULONG;
+        else if constexpr (std::is_same_v<Promoted, long long>) return TC_LOG_ARG_LLONG;
+        else return TC_LOG_ARG_ULLONG;
+    } else {
+        static_assert(log_always_false<T>, "unsupported deferred log argument type");
+        return 0;
+    }
+}
+
+template<typename T>
+std::string_view log_arg_string(const T& v) {
+    using D = std::remove_cv_t<std::remove_reference_t<T>>;
+    if constexpr (std::is_same_v<D, std::string> || std::is_same_v<D, std::string_view>) {
+        return std::string_view(v);
+    } else if constexpr (std::is_array_v<D>) {
+        // Literals and char arrays are never null
+        return std::string_view(v);
+    } else {
+        return v ? std::string_view(v) : std::string_view("(null)");
+    }
+}
+
+// Encoded size: one cell, or length + bytes + NUL padded to a cell
+template<typename T>
+size_t log_arg_size(const T& v) {
+    if constexpr (log_arg_type<T>() == TC_LOG_ARG_STR) {
+        size_t n = sizeof(uint32_t) + log_arg_string(v).size() + 1;
+        return (n + TC_LOG_ARG_CELL - 1) & ~size_t(TC_LOG_ARG_CELL - 1);
+    } else {
+        return TC_LOG_ARG_CELL;
+    }
+}
+
+template<typename T>
+char* log_arg_write(char* p, const T& v) {
+    using D = std::remove_cv_t<std::remove_reference_t<T>>;
+    constexpr uint8_t type = log_arg_type<T>();
+    if constexpr (type == TC_LOG_ARG_STR) {
+        std::string_view s = log_arg_string(v);
+        uint32_t len = static_cast<uint32_t>(s.size());
+        memcpy(p, &len, sizeof(len));
+        memcpy(p + sizeof(len), s.data(), s.size());
+        p[sizeof(len) + s.size()] = '\0';
+        return p + log_arg_size(v);
+    } else {
+        if constexpr (type == TC_LOG_ARG_PTR) {
+            const void* value = v;
+            memcpy(p, &value, sizeof(value));
+        } else if constexpr (type == TC_LOG_ARG_DOUBLE) {
+            double value = v;
+            memcpy(p, &value, sizeof(value));
+        } else if constexpr (std::is_enum_v<D>) {
+            auto value = +static_cast<std::underlying_type_t<D>>(v);
+            memcpy(p, &value, sizeof(value));
+        } else {
+            auto value = +v;
+            memcpy(p, &value, sizeof(value));
+        }
+        return p + TC_LOG_ARG_CELL;
+    }
+}
+
+template<typename... Args>
+inline constexpr uint8_t log_arg_types[] = {log_arg_type<Args>()..., 0};
+
+template<typename... Args>
+void log_deferred(tc_log_level level, const char* format, const Args&... args) {
+    if (!log_enabled(level)) return;
+
+    size_t size = (size_t(0) + ... + log_arg_size(args));
+    const uint8_t* types = log_arg_types<Args...>;
+    uint32_t count = static_cast<uint32_t>(sizeof...(Args));
+
+    void* out = tc_log_binary_begin(level, format, types, count, size);
+    if (out) {
+        char* p = static_cast<char*>(out);
+        ((p = log_arg_write(p, args)), ...);
+        (void)p;
+        tc_log_binary_commit();
+        // Errors often precede a crash: do not leave them buffered
+        if (level >= TC_LOG_ERROR) tc_log_flush();
+        return;
+    }
+
+    // No room in the thread buffer: encode locally and format now
+    std::vector<char> local(size + TC_LOG_ARG_CELL);
+    char* p = local.data();
+    ((p = log_arg_write(p, args)), ...);
+    (void)p;
+    tc_log_binary_log_now(level, format, types, count, local.data());
+}
+
+} // namespace detail
+
 // Static logging class for C++ code
 // Usage:
 //   tc::Log::info("Loading asset: %s", name.c_str());
@@ -18,77 +154,157 @@ public:
     // Format string logging (printf-style)
     template<typename... Args>
     static void debug(const char* format, Args... args) {
-        tc_log_debug(format, args...);
+        if constexpr (TC_LOG_DEBUG >= TC_LOG_COMPILED_LEVEL) {
+            if (log_enabled(TC_LOG_DEBUG)) tc_log_debug(format, args...);
+        }
     }
 
     template<typename... Args>
     static void info(const char* format, Args... args) {
-        tc_log_info(format, args...);
+        if constexpr (TC_LOG_INFO >= TC_LOG_COMPILED_LEVEL) {
+            if (log_enabled(TC_LOG_INFO)) tc_log_info(format, args...);
+        }
     }
 
     template<typename... Args>
     static void warn(const char* format, Args... args) {
-        tc_log_warn(format, args...);
+        if constexpr (TC_LOG_WARN >= TC_LOG_COMPILED_LEVEL) {
+            if (log_enabled(TC_LOG_WARN)) tc_log_warn(format, args...);
+        }
     }
 
     template<typename... Args>
     static void error(const char* format, Args... args) {
-        tc_log_error(format, args...);
+        if constexpr (TC_LOG_ERROR >= TC_LOG_COMPILED_LEVEL) {
+            if (log_enabled(TC_LOG_ERROR)) tc_log_error(format, args...);
+        }
     }
 
     // Simple string logging
     static void debug(const std::string& msg) {
-        tc_log_debug("%s", msg.c_str());
+        if constexpr (TC_LOG_DEBUG >= TC_LOG_COMPILED_LEVEL) {
+            if (log_enabled(TC_LOG_DEBUG)) tc_log_debug("%s", msg.c_str());
+        }
     }
 
     static void info(const std::string& msg) {
-        tc_log_info("%s", msg.c_str());
+        if constexpr (TC_LOG_INFO >= TC_LOG_COMPILED_LEVEL) {
+            if (log_enabled(TC_LOG_INFO)) tc_log_info("%s", msg.c_str());
+        }
     }
 
     static void warn(const std::string& msg) {
-        tc_log_warn("%s", msg.c_str());
+        if constexpr (TC_LOG_WARN >= TC_LOG_COMPILED_LEVEL) {
+            if (log_enabled(TC_LOG_WARN)) tc_log_warn("%s", msg.c_str());
+        }
     }
 
     static void error(const std::string& msg) {
-        tc_log_error("%s", msg.c_str());
+        if constexpr (TC_LOG_ERROR >= TC_LOG_COMPILED_LEVEL) {
+            if (log_enabled(TC_LOG_ERROR)) tc_log_error("%s", msg.c_str());
+        }
     }
 
     // Exception logging with context
     static void debug(const std::exception& e, const char* context = nullptr) {
-        log_exception(TC_LOG_DEBUG, e, context);
+        if constexpr (TC_LOG_DEBUG >= TC_LOG_COMPILED_LEVEL) {
+            if (log_enabled(TC_LOG_DEBUG)) log_exception(TC_LOG_DEBUG, e, context);
+        }
     }
 
     static void info(const std::exception& e, const char* context = nullptr) {
-        log_exception(TC_LOG_INFO, e, context);
+        if constexpr (TC_LOG_INFO >= TC_LOG_COMPILED_LEVEL) {
+            if (log_enabled(TC_LOG_INFO)) log_exception(TC_LOG_INFO, e, context);
+        }
     }
 
     static void warn(const std::exception& e, const char* context = nullptr) {
-        log_exception(TC_LOG_WARN, e, context);
+        if constexpr (TC_LOG_WARN >= TC_LOG_COMPILED_LEVEL) {
+            if (log_enabled(TC_LOG_WARN)) log_exception(TC_LOG_WARN, e, context);
+        }
     }
 
     static void error(const std::exception& e, const char* context = nullptr) {
-        log_exception(TC_LOG_ERROR, e, context);
+        if constexpr (TC_LOG_ERROR >= TC_LOG_COMPILED_LEVEL) {
+            if (log_enabled(TC_LOG_ERROR)) log_exception(TC_LOG_ERROR, e, context);
+        }
     }
 
     // Exception logging with format string context
     template<typename... Args>
     static void debug(const std::exception& e, const char* format, Args... args) {
-        log_exception_fmt(TC_LOG_DEBUG, e, format, args...);
+        if constexpr (TC_LOG_DEBUG >= TC_LOG_COMPILED_LEVEL) {
+            if (log_enabled(TC_LOG_DEBUG)) log_exception_fmt(TC_LOG_DEBUG, e, format, args...);
+        }
     }
 
     template<typename... Args>
     static void info(const std::exception& e, const char* format, Args... args) {
-        log_exception_fmt(TC_LOG_INFO, e, format, args...);
+        if constexpr (TC_LOG_INFO >= TC_LOG_COMPILED_LEVEL) {
+            if (log_enabled(TC_LOG_INFO)) log_exception_fmt(TC_LOG_INFO, e, format, args...);
+        }
     }
 
     template<typename... Args>
     static void warn(const std::exception& e, const char* format, Args... args) {
-        log_exception_fmt(TC_LOG_WARN, e, format, args...);
+        if constexpr (TC_LOG_WARN >= TC_LOG_COMPILED_LEVEL) {
+            if (log_enabled(TC_LOG_WARN)) log_exception_fmt(TC_LOG_WARN, e, format, args...);
+        }
     }
 
     template<typename... Args>
     static void error(const std::exception& e, const char* format, Args... args) {
-        log_exception_fmt(TC_LOG_ERROR, e, format, args...);
+        if constexpr (TC_LOG_ERROR >= TC_LOG_COMPILED_LEVEL) {
+            if (log_enabled(TC_LOG_ERROR)) log_exception_fmt(TC_LOG_ERROR, e, format, args...);
+        }
+    }
+
+    // Deferred logging for hot paths: arguments are copied as binary into a
+    // per-thread buffer and formatted later off the calling thread (or at
+    // tc_log_flush). The format must be a string literal. Supported
+    // arguments: integers, enums, floating point, pointers, const char*,
+    // std::string and std::string_view (strings are copied).
+    // Records keep their order relative to plain tc_log calls from the same
+    // thread. In async mode the writer thread formats them promptly; without
+    // it they are written at the thread's next tc_log call, tc_log_flush, an
+    // ERROR, a full buffer or exit.
+    // Usage:
+    //   tc::Log::Deferred::debug("frame %d: %zu draws", frame, draws);
+    struct Deferred {
+        template<typename... Args>
+        static void debug(LogFormat format, const Args&... args) {
+            if constexpr (TC_LOG_DEBUG >= TC_LOG_COMPILED_LEVEL) {
+                detail::log_deferred(TC_LOG_DEBUG, format.c_str(), args...);
+            }
+        }
+
+        template<typename... Args>
+        static void info(LogFormat format, const Args&... args) {
+            if constexpr (TC_LOG_INFO >= TC_LOG_COMPILED_LEVEL) {
+                detail::log_deferred(TC_LOG_INFO, format.c_str(), args...);
+            }
+        }
+
+        template<typename... Args>
+        static void warn(LogFormat format, const Args&... args) {
+            if constexpr (TC_LOG_WARN >= TC_LOG_COMPILED_LEVEL) {
+                detail::log_deferred(TC_LOG_WARN, format.c_str(), args...);
+            }
+        }
+
+        template<typename... Args>
+        static void error(LogFormat format, const Args&... args) {
+            if constexpr (TC_LOG_ERROR >= TC_LOG_COMPILED_LEVEL) {
+                detail::log_deferred(TC_LOG_ERROR, format.c_str(), args...);
+            }
+        }
+    };
+
+    // Inline level check, for guarding expensive message construction:
+    //   if (tc::Log::enabled(TC_LOG_DEBUG)) { ... }
+    // The TC_DEBUG/TC_INFO/... macros in tc_log.h do this around tc_log.
+    static bool enabled(tc_log_level level) {
+        return level >= TC_LOG_COMPILED_LEVEL && log_enabled(level);
     }
 
     // Configuration
@@ -0,0 +1,62 @@
+// tc_log_binary.h - Deferred binary logging
+// Hot paths record the format pointer, a timestamp, the thread and the raw
+// argument bytes into a per-thread buffer; the text is produced later by
+// whoever drains the buffers (the async writer, tc_log_flush, or a thread
+// whose buffer filled up). Use it through tc::Log::Deferred in tc_log.hpp.
+#pragma once
+
+#include <tcbase/tc_log.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Argument encodings, by printf default-promoted type. Fixed-size values
+// take one 8-byte cell; TC_LOG_ARG_STR is a uint32 length followed by the
+// bytes and a NUL, padded to 8 bytes.
+typedef enum {
+    TC_LOG_ARG_INT = 0,
+    TC_LOG_ARG_UINT,
+    TC_LOG_ARG_LONG,
+    TC_LOG_ARG_ULONG,
+    TC_LOG_ARG_LLONG,
+    TC_LOG_ARG_ULLONG,
+    TC_LOG_ARG_DOUBLE,
+    TC_LOG_ARG_PTR,
+    TC_LOG_ARG_STR
+} tc_log_arg_type;
+
+#define TC_LOG_ARG_CELL 8
+
+// Reserve args_size bytes for a record in the calling thread's buffer.
+// format and arg_types must stay valid until the record is drained
+// (string literals and static arrays). Returns where to write the
+// encoded arguments, or NULL if the record cannot be stored; the caller
+// should then log synchronously instead.
+TCBASE_API void* tc_log_binary_begin(
+    tc_log_level level,
+    const char* format,
+    const uint8_t* arg_types,
+    uint32_t arg_count,
+    size_t args_size
+);
+
+// Publish the record started by the last tc_log_binary_begin on this thread
+TCBASE_API void tc_log_binary_commit(void);
+
+// Format and log a record immediately (used when begin returns NULL)
+TCBASE_API void tc_log_binary_log_now(
+    tc_log_level level,
+    const char* format,
+    const uint8_t* arg_types,
+    uint32_t arg_count,
+    const void* args
+);
+
+// Format and deliver all pending records, oldest first across threads.
+// tc_log_flush and the async writer call this too.
+TCBASE_API void tc_log_binary_drain(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,85 @@
+// tc_log_sink.h - Pluggable tc_log output sinks
+// Every message that passes the global level goes to each registered sink
+// whose own level it also passes. A stderr sink is registered at startup
+// as TC_LOG_STDERR_SINK; remove it to stop writing to stderr.
+#pragma once
+
+#include <tcbase/tc_log.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// Sink registry
+// ============================================================================
+
+typedef uint32_t tc_log_sink_id;
+
+#define TC_LOG_SINK_INVALID 0u
+#define TC_LOG_STDERR_SINK 1u
+
+// len is the message length without a trailing newline; message[len] is
+// '\0', but sinks should not need strlen. Sink calls are serialized.
+typedef void (*tc_log_sink_write_fn)(void* user_data, tc_log_level level, const char* message, size_t len);
+typedef void (*tc_log_sink_fn)(void* user_data);
+
+typedef struct tc_log_sink_desc {
+    tc_log_sink_write_fn write;
+    tc_log_sink_fn flush;          // End of a batch, and tc_log_flush (can be NULL)
+    tc_log_sink_fn destroy;        // On removal (can be NULL)
+    void* user_data;
+    tc_log_level min_level;
+} tc_log_sink_desc;
+
+// Register a sink. Returns TC_LOG_SINK_INVALID on failure.
+TCBASE_API tc_log_sink_id tc_log_add_sink(const tc_log_sink_desc* desc);
+
+// Flush, destroy and unregister a sink. Returns false if id is unknown.
+TCBASE_API bool tc_log_remove_sink(tc_log_sink_id id);
+
+// Per-sink level filter
+TCBASE_API bool tc_log_sink_set_level(tc_log_sink_id id, tc_log_level min_level);
+
+// ============================================================================
+// Built-in sinks
+// ============================================================================
+
+// "[LEVEL] message" lines on stderr, flushed per batch
+TCBASE_API tc_log_sink_id tc_log_add_stderr_sink(tc_log_level min_level);
+
+typedef struct tc_log_file_options {
+    uint64_t max_bytes;            // Rotate before exceeding this size (0 = no limit)
+    uint32_t max_age_seconds;      // Rotate files older than this (0 = no limit)
+    uint32_t max_files;            // Rotated files kept as path.1 .. path.N
+    size_t buffer_bytes;           // Batch buffer (0 = 64 KiB)
+    bool append;                   // Keep an existing file instead of truncating
+} tc_log_file_options;
+
+// "[LEVEL] message" lines in a file. Lines are batched and written with
+// writev at the end of each delivery batch (every message in synchronous
+// mode, every writer wakeup in async mode) or when the buffer fills.
+// options may be NULL for defaults (no rotation).
+TCBASE_API tc_log_sink_id tc_log_add_file_sink(
+    const char* path,
+    const tc_log_file_options* options,
+    tc_log_level min_level
+);
+
+// Call fn for every message
+TCBASE_API tc_log_sink_id tc_log_add_callback_sink(
+    tc_log_sink_write_fn fn,
+    void* user_data,
+    tc_log_level min_level
+);
+
+// Keep the most recent lines in memory, up to capacity bytes
+TCBASE_API tc_log_sink_id tc_log_add_memory_sink(size_t capacity, tc_log_level min_level);
+
+// Copy a memory sink's lines, oldest first, "\n"-separated and
+// NUL-terminated, into out. Returns the full length (as snprintf).
+TCBASE_API size_t tc_log_memory_sink_read(tc_log_sink_id id, char* out, size_t out_size);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,267 @@
+// tc_pool.hpp - Typed C++ wrapper over tc_pool
+#pragma once
+
+#include <tcbase/tc_pool.h>
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace tc {
+
+// Typed handle: same layout as tc_handle
+template<typename T>
+struct PoolHandle {
+    tc_handle raw = TC_HANDLE_INVALID;
+
+    PoolHandle() = default;
+    explicit PoolHandle(tc_handle h) : raw(h) {}
+
+    bool is_invalid() const { return tc_handle_is_invalid(raw); }
+    explicit operator bool() const { return !is_invalid(); }
+
+    friend bool operator==(PoolHandle a, PoolHandle b) { return tc_handle_eq(a.raw, b.raw); }
+    friend bool operator!=(PoolHandle a, PoolHandle b) { return !tc_handle_eq(a.raw, b.raw); }
+};
+
+static_assert(sizeof(PoolHandle<int>) == sizeof(tc_handle), "PoolHandle must match tc_handle");
+
+// Non-owning typed view over a tc_pool whose items are T.
+// Lookups are inline with sizeof(T) as a compile-time stride, so the
+// generation check is visible to the optimizer.
+// Usage:
+//   tc::PoolView<Body> bodies(c_pool);
+//   if (Body* b = bodies.get(h)) { ... }
+//   for (Body& b : bodies) { ... }
+template<typename T>
+class PoolView {
+public:
+    using value_type = T;
+    using handle_type = PoolHandle<T>;
+
+    static constexpr size_t item_size = sizeof(T);
+    static constexpr size_t item_alignment = alignof(T);
+
+    explicit PoolView(tc_pool* pool) : pool_(pool) {
+        assert(pool_->item_size == item_size && pool_->item_stride == item_size);
+    }
+
+    // Raw C pool, for sharing with C code
+    tc_pool* c_pool() const { return pool_; }
+
+    uint32_t size() const { return pool_->count; }
+    bool empty() const { return pool_->count == 0; }
+
+    bool contains(handle_type h) const {
+        uint32_t index = h.raw.index;
+        return index < pool_->capacity &&
+               tc_pool_slot_occupied(pool_, index) &&
+               pool_->generations[index] == h.raw.generation;
+    }
+
+    T* get(handle_type h) const {
+        return contains(h) ? item_at(h.raw.index) : nullptr;
+    }
+
+    // No validation - use carefully!
+    T* get_unchecked(uint32_t index) const {
+        return item_at(index);
+    }
+
+    bool destroy(handle_type h) {
+        return tc_pool_free_slot(pool_, h.raw);
+    }
+
+    void clear() {
+        tc_pool_clear(pool_);
+    }
+
+    // ========================================================================
+    // Iteration over live items (dense order in dense mode, slot order otherwise)
+    // ========================================================================
+
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        iterator() = default;
+        iterator(const tc_pool* pool, uint32_t pos) : pool_(pool), pos_(pos) {
+            if (!tc_pool_dense_items(pool_)) seek(pos_);
+        }
+
+        T& operator*() const { return *PoolView::item_at_slot(pool_, index()); }
+        T* operator->() const { return PoolView::item_at_slot(pool_, index()); }
+
+        // Slot index of the current item
+        uint32_t index() const {
+            return tc_pool_dense_items(pool_) ? tc_pool_dense_slot(pool_, pos_) : pos_;
+        }
+
+        handle_type handle() const {
+            tc_handle h;
+            h.index = index();
+            h.generation = pool_->generations[h.index];
+            return handle_type(h);
+        }
+
+        iterator& operator++() {
+            if (tc_pool_dense_items(pool_)) {
+                pos_++;
+            } else {
+                seek(pos_ + 1);
+            }
+            return *this;
+        }
+
+        iterator operator++(int) {
+            iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        friend bool operator==(const iterator& a, const iterator& b) { return a.pos_ == b.pos_; }
+        friend bool operator!=(const iterator& a, const iterator& b) { return a.pos_ != b.pos_; }
+
+    private:
+        // Move to the first occupied slot at or after from (capacity if none)
+        void seek(uint32_t from) {
+            uint32_t words = TC_POOL_WORD_COUNT(pool_->capacity);
+            uint32_t w = from / TC_POOL_WORD_BITS;
+            if (w >= words) {
+                pos_ = pool_->capacity;
+                return;
+            }
+            uint64_t bits = pool_->occupied[w] & (~uint64_t(0) << (from % TC_POOL_WORD_BITS));
+            while (!bits) {
+                if (++w >= words) {
+                    pos_ = pool_->capacity;
+                    return;
+                }
+                bits = pool_->occupied[w];
+            }
+            pos_ = w * TC_POOL_WORD_BITS + tc_pool_ctz64(bits);
+        }
+
+        const tc_pool* pool_ = nullptr;
+        uint32_t pos_ = 0;
+    };
+
+    iterator begin() const { return iterator(pool_, 0); }
+    iterator end() const { return iterator(pool_, end_pos()); }
+
+protected:
+    PoolView() = default;
+
+    static T* item_at_slot(const tc_pool* pool, uint32_t index) {
+        if (pool->pages) {
+            uint32_t offset = index & ((1u << pool->page_shift) - 1);
+            return static_cast<T*>(pool->pages[index >> pool->page_shift]) + offset;
+        }
+        if (pool->slot_to_dense) index = pool->slot_to_dense[index];
+        return static_cast<T*>(pool->data) + index;
+    }
+
+    T* item_at(uint32_t index) const { return item_at_slot(pool_, index); }
+
+    uint32_t end_pos() const {
+        return tc_pool_dense_items(pool_) ? pool_->count : pool_->capacity;
+    }
+
+    tc_pool* pool_ = nullptr;
+};
+
+// Owning typed pool. The underlying tc_pool is an ordinary C pool
+// (c_pool()), so C code can look up and iterate the same items.
+// Non-trivial types get init/destroy/relocate hooks, so items are
+// constructed, destroyed and moved correctly from C calls too.
+template<typename T>
+class Pool : public PoolView<T> {
+    static_assert(alignof(T) <= TC_POOL_MAX_ALIGNMENT,
+                  "tc::Pool item alignment exceeds TC_POOL_MAX_ALIGNMENT");
+
+public:
+    using handle_type = PoolHandle<T>;
+
+    explicit Pool(uint32_t flags = 0, uint32_t initial_capacity = 0) {
+        tc_pool_desc desc = {};
+        desc.item_size = sizeof(T);
+        desc.alignment = alignof(T);
+        desc.initial_capacity = initial_capacity;
+        desc.flags = flags;
+
+        if constexpr (!std::is_trivially_default_constructible_v<T>) {
+            static_assert(std::is_default_constructible_v<T>,
+                          "tc::Pool items must be default constructible");
+            desc.flags |= TC_POOL_NO_ZERO;
+            desc.init = &Pool::init_item;
+        }
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            desc.destroy = &Pool::destroy_item;
+        }
+        if constexpr (!std::is_trivially_copyable_v<T>) {
+            desc.relocate = &Pool::relocate_item;
+        }
+
+        if (!tc_pool_init_ex(&storage_, &desc)) {
+            throw std::bad_alloc();
+        }
+        this->pool_ = &storage_;
+    }
+
+    ~Pool() {
+        tc_pool_free(&storage_);
+    }
+
+    Pool(const Pool&) = delete;
+    Pool& operator=(const Pool&) = delete;
+
+    // Construct an item in place
+    template<typename... Args>
+    handle_type create(Args&&... args) {
+        // The init hook would default-construct; construct from args instead
+        tc_pool_item_fn init = storage_.init_fn;
+        storage_.init_fn = nullptr;
+        tc_handle h = tc_pool_alloc(&storage_);
+        storage_.init_fn = init;
+        if (tc_handle_is_invalid(h)) return handle_type();
+
+        T* item = this->item_at(h.index);
+        try {
+            new (item) T(std::forward<Args>(args)...);
+        } catch (...) {
+            // Slot holds no object: release it without the destroy hook
+            tc_pool_item_fn destroy = storage_.destroy_fn;
+            storage_.destroy_fn = nullptr;
+            tc_pool_free_slot(&storage_, h);
+            storage_.destroy_fn = destroy;
+            throw;
+        }
+        return handle_type(h);
+    }
+
+private:
+    static void init_item(void* item, void*) {
+        new (item) T();
+    }
+
+    static void destroy_item(void* item, void*) {
+        static_cast<T*>(item)->~T();
+    }
+
+    static void relocate_item(void* dst, void* src, void*) {
+        T* from = static_cast<T*>(src);
+        new (dst) T(std::move(*from));
+        from->~T();
+    }
+
+    tc_pool storage_;
+};
+
+} // namespace tc
@@ -0,0 +1,61 @@
+// tc_pool_mt.h - Concurrent object pool with lock-free alloc/free
+// Same handle semantics as tc_pool, but every operation may be called
+// from any thread without external locking.
+#pragma once
+
+#include <tcbase/tcbase_api.h>
+#include <tcbase/tc_binding_types.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// Concurrent pool
+// ============================================================================
+//
+// Storage is paged: items never move, pages are only released by
+// tc_pool_mt_free. Slots come from a tagged lock-free free list, or from
+// never-used space when the list is empty. Generation and occupancy are
+// published in one atomic word, so is_valid/get are wait-free.
+
+typedef struct tc_pool_mt tc_pool_mt;
+
+// Default upper bound on slots when max_capacity is 0
+#define TC_POOL_MT_DEFAULT_MAX_CAPACITY (1u << 24)
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+// Create pool. max_capacity bounds the page table (0 = default).
+TCBASE_API tc_pool_mt* tc_pool_mt_new(size_t item_size, uint32_t max_capacity);
+
+// Destroy pool. No other thread may use it concurrently.
+TCBASE_API void tc_pool_mt_free(tc_pool_mt* pool);
+
+// ============================================================================
+// Operations (thread-safe)
+// ============================================================================
+
+// Allocate a zeroed slot, returns TC_HANDLE_INVALID when max_capacity is exhausted
+TCBASE_API tc_handle tc_pool_mt_alloc(tc_pool_mt* pool);
+
+// Free a slot (returns false if handle is stale or already freed)
+TCBASE_API bool tc_pool_mt_free_slot(tc_pool_mt* pool, tc_handle h);
+
+// Check if handle is valid (wait-free)
+TCBASE_API bool tc_pool_mt_is_valid(const tc_pool_mt* pool, tc_handle h);
+
+// Get pointer to item by handle (wait-free, NULL if invalid).
+// The pointer stays addressable until tc_pool_mt_free; synchronizing
+// access to the item against a concurrent free is up to the caller.
+TCBASE_API void* tc_pool_mt_get(const tc_pool_mt* pool, tc_handle h);
+
+// Number of occupied slots (a snapshot under concurrent use)
+TCBASE_API uint32_t tc_pool_mt_count(const tc_pool_mt* pool);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,79 @@
+// tc_resource_map_mt.h - Concurrent read-mostly resource map by UUID
+// Same semantics as tc_resource_map. Lookups are lock-free and may run on
+// any thread while another thread adds or removes entries.
+#pragma once
+
+#include <tcbase/tcbase_api.h>
+#include <tcbase/tc_resource_map.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// Concurrent resource map
+// ============================================================================
+//
+// Each entry is an immutable node (hash, key, value) published into an
+// open-addressed slot array with a single atomic store. Readers never
+// lock or write shared memory. Writers serialize on a mutex, and a growing
+// or tombstone-heavy table is rebuilt and swapped in whole (RCU style).
+// Removed nodes and old tables are freed by epoch-based reclamation once
+// no reader can still see them.
+//
+// A resource pointer returned by get stays valid until its entry is
+// removed; keeping resources alive while other threads use them is up to
+// the caller, as with tc_resource_map.
+
+typedef struct tc_resource_map_mt tc_resource_map_mt;
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+// Create a new map; destructor is called when resources are removed or the map is destroyed (can be NULL)
+TCBASE_API tc_resource_map_mt* tc_resource_map_mt_new(tc_resource_free_fn destructor);
+
+// Destroy map and all resources. No other thread may use it concurrently.
+TCBASE_API void tc_resource_map_mt_free(tc_resource_map_mt* map);
+
+// ============================================================================
+// Writers (thread-safe, serialized internally)
+// ============================================================================
+
+// Add resource with given UUID. Returns false if UUID already exists
+TCBASE_API bool tc_resource_map_mt_add(tc_resource_map_mt* map, const char* uuid, void* resource);
+
+// Remove resource by UUID (calls destructor). Returns true if removed
+TCBASE_API bool tc_resource_map_mt_remove(tc_resource_map_mt* map, const char* uuid);
+
+// ============================================================================
+// Readers (lock-free)
+// ============================================================================
+
+// Get resource by UUID, returns NULL if not found
+TCBASE_API void* tc_resource_map_mt_get(const tc_resource_map_mt* map, const char* uuid);
+
+// Same with hash = tc_resource_map_hash(uuid)
+TCBASE_API void* tc_resource_map_mt_get_hashed(const tc_resource_map_mt* map, const char* uuid, uint64_t hash);
+
+// Check if UUID exists
+TCBASE_API bool tc_resource_map_mt_contains(const tc_resource_map_mt* map, const char* uuid);
+
+// Number of resources (a snapshot under concurrent use)
+TCBASE_API size_t tc_resource_map_mt_count(const tc_resource_map_mt* map);
+
+// Visit entries. Entries added or removed during the walk may or may not
+// be visited. Return false from callback to stop.
+TCBASE_API void tc_resource_map_mt_foreach(
+    const tc_resource_map_mt* map,
+    tc_resource_iter_fn callback,
+    void* user_data
+);
+
+#ifdef __cplusplus
+}
+#endif
@@ -4,6 +4,9 @@
 // Shared logging system for all termin libraries.
 
 #include "tcbase_api.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -16,15 +19,20 @@ typedef enum {
     TC_LOG_ERROR = 3
 } tc_log_level;
 
-// Callback for log interception (e.g. for editor console)
+// Callback for log interception (e.g. for editor console).
+// In async mode it runs on the log writer thread.
 typedef void (*tc_log_callback)(tc_log_level level, const char* message);
 
-// Set callback for log interception
+// Set callback for log interception. It is registered as a sink ahead of
+// stderr (see tc_log_sink.h); NULL removes it.
 TCBASE_API void tc_log_set_callback(tc_log_callback callback);
 
 // Set minimum log level
 TCBASE_API void tc_log_set_level(tc_log_level min_level);
 
+// True if messages at level pass the minimum level
+TCBASE_API bool tc_log_enabled(tc_log_level level);
+
 // Log with specified level (printf-style)
 TCBASE_API void tc_log(tc_log_level level, const char* format, ...);
 
@@ -33,8 +41,79 @@ TCBASE_API void tc_log_info(const char* format, ...);
 TCBASE_API void tc_log_warn(const char* format, ...);
 TCBASE_API void tc_log_error(const char* format, ...);
 
+// Async mode: tc_log formats on the calling thread and copies the message
+// into a lock-free ring; a background thread writes it out and runs the
+// callback. ERROR messages are flushed before tc_log returns, and the ring
+// is drained at exit.
+
+typedef enum {
+    TC_LOG_OVERFLOW_BLOCK = 0,   // Wait for the writer to free space
+    TC_LOG_OVERFLOW_DROP = 1,    // Drop the message
+    TC_LOG_OVERFLOW_COUNT = 2    // Drop, and log how many were dropped once there is room
+} tc_log_overflow;
+
+// Start the writer thread with a ring of at least ring_bytes. Messages
+// longer than a quarter of the ring are truncated. Returns true if
+// running (or already running).
+TCBASE_API bool tc_log_start_async(size_t ring_bytes, tc_log_overflow policy);
+
+// Drain the ring, stop the writer and return to synchronous logging
+TCBASE_API void tc_log_stop_async(void);
+
+// Block until every message logged so far has been written
+TCBASE_API void tc_log_flush(void);
+
+// Messages dropped by the async ring since startup
+TCBASE_API uint64_t tc_log_dropped(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+// ============================================================================
+// Level-checked macros
+// ============================================================================
+//
+// TC_LOG_COMPILED_LEVEL is the build-time minimum: macro calls below it
+// (and the tc::Log methods) compile to nothing. Define it before including,
+// e.g. -DTC_LOG_COMPILED_LEVEL=1 strips DEBUG; 4 strips everything.
+// The runtime level is checked before the arguments are evaluated, so
+//   TC_DEBUG("mesh %s", describe(mesh).c_str());
+// never calls describe() while DEBUG is filtered out.
+
+#ifndef TC_LOG_COMPILED_LEVEL
+#define TC_LOG_COMPILED_LEVEL 0
+#endif
+
 #ifdef __cplusplus
+#include <atomic>
+
+namespace tc {
+namespace detail {
+// Written by tc_log_set_level; read inline by log_enabled
+TCBASE_API extern std::atomic<int> log_min_level;
+} // namespace detail
+
+inline bool log_enabled(tc_log_level level) {
+    return level >= detail::log_min_level.load(std::memory_order_relaxed);
 }
+} // namespace tc
+
+#define TC_LOG_ENABLED(level) ::tc::log_enabled(level)
+#else
+#define TC_LOG_ENABLED(level) tc_log_enabled(level)
 #endif
 
+#define TC_LOG_AT(level, ...) \
+    do { \
+        if ((level) >= TC_LOG_COMPILED_LEVEL && TC_LOG_ENABLED(level)) { \
+            tc_log((level), __VA_ARGS__); \
+        } \
+    } while (0)
+
+#define TC_DEBUG(...) TC_LOG_AT(TC_LOG_DEBUG, __VA_ARGS__)
+#define TC_INFO(...) TC_LOG_AT(TC_LOG_INFO, __VA_ARGS__)
+#define TC_WARN(...) TC_LOG_AT(TC_LOG_WARN, __VA_ARGS__)
+#define TC_ERROR(...) TC_LOG_AT(TC_LOG_ERROR, __VA_ARGS__)
+
 #endif // TC_LOG_H
@@ -6,6 +6,10 @@
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -17,20 +21,125 @@ extern "C" {
 #define TC_SLOT_FREE     0
 #define TC_SLOT_OCCUPIED 1
 
+// Occupancy is stored as a bitmap: bit (i % 64) of word (i / 64) is set
+// for occupied slot i. Bits at or past capacity are always clear.
+#define TC_POOL_WORD_BITS 64
+#define TC_POOL_WORD_COUNT(slots) (((slots) + TC_POOL_WORD_BITS - 1) / TC_POOL_WORD_BITS)
+
+// ============================================================================
+// Pool flags
+// ============================================================================
+
+// Dense mode: live items are kept packed in data[0..count).
+// Removal moves the last live item into the freed position, so item
+// pointers are only valid until the next tc_pool_free_slot.
+#define TC_POOL_DENSE (1u << 0)
+
+// Paged mode: items live in fixed-size pages behind a page table.
+// Growth adds a page and never moves items, so item pointers stay valid
+// for the lifetime of the slot. Pages that become empty are released.
+// Cannot be combined with TC_POOL_DENSE.
+#define TC_POOL_PAGED (1u << 1)
+
+// Read-only pool viewing a memory-mapped image (set by tc_pool_restore with
+// TC_POOL_RESTORE_MAP). Lookups and iteration work; alloc/free/clear fail.
+#define TC_POOL_MAPPED (1u << 2)
+
+// Skip zero-filling items on alloc and growth. Item memory is
+// uninitialized until written (or until the init hook runs).
+#define TC_POOL_NO_ZERO (1u << 3)
+
+// Back item storage with huge pages (MAP_HUGETLB / MEM_LARGE_PAGES when the
+// OS has them reserved, transparent huge pages otherwise). Blocks are rounded
+// up to TC_POOL_HUGE_PAGE_BYTES; paged pools default to one huge page per page.
+#define TC_POOL_HUGE_PAGES (1u << 4)
+
+// Marks a slot that has no dense position (dense mode only)
+#define TC_POOL_NO_DENSE UINT32_MAX
+
+// Default page size in bytes for paged mode
+#define TC_POOL_DEFAULT_PAGE_BYTES (64 * 1024)
+
+// Huge page granularity assumed by TC_POOL_HUGE_PAGES
+#define TC_POOL_HUGE_PAGE_BYTES (2 * 1024 * 1024)
+
+// Alignment malloc already guarantees; larger alignments use aligned allocation
+#define TC_POOL_MALLOC_ALIGN (2 * sizeof(void*))
+
+// Largest supported item alignment
+#define TC_POOL_MAX_ALIGNMENT 4096
+
+// ============================================================================
+// Item hooks
+// ============================================================================
+
+typedef struct tc_pool tc_pool;
+
+// Construct/destroy one item in place
+typedef void (*tc_pool_item_fn)(void* item, void* user_data);
+
+// Move an item to uninitialized memory; src is treated as destroyed afterwards
+typedef void (*tc_pool_relocate_fn)(void* dst, void* src, void* user_data);
+
+// Construct the items of freshly allocated handles (used by tc_pool_alloc_n)
+typedef void (*tc_pool_batch_init_fn)(tc_pool* pool, const tc_handle* handles, uint32_t n, void* user_data);
+
 // ============================================================================
 // Generic pool structure
 // ============================================================================
 
-typedef struct tc_pool {
+struct tc_pool {
     void* data;              // Array of items (type-specific)
     uint32_t* generations;   // Generation per slot
-    uint8_t* states;         // TC_SLOT_FREE or TC_SLOT_OCCUPIED
+    uint64_t* occupied;      // Occupancy bitmap, one bit per slot
     uint32_t* free_list;     // Indices of free slots
     uint32_t capacity;       // Total slots
     uint32_t count;          // Occupied slots
     uint32_t free_count;     // Free slots in free_list
     size_t item_size;        // Size of each item
-} tc_pool;
+    size_t item_stride;      // Bytes between consecutive items (>= item_size)
+    size_t alignment;        // Item alignment (0 = malloc default)
+    size_t data_bytes;       // Allocated size of data (flat and dense modes)
+    uint32_t flags;          // TC_POOL_* flags
+    uint32_t* slot_to_dense; // Slot index -> dense position (dense mode only)
+    uint32_t* dense_to_slot; // Dense position -> slot index (dense mode only)
+    void** pages;            // Page table (paged mode only)
+    uint32_t* page_live;     // Occupied slots per page (paged mode only)
+    uint32_t page_count;     // Entries in page table
+    uint32_t page_shift;     // log2(items per page)
+    uint32_t meta_capacity;  // Allocated length of per-slot arrays
+    void* spare_page;        // Released page kept for reuse (paged mode only)
+    uint32_t generation_base; // Initial generation for newly created slots
+    void* mapping;           // Mapped image base (TC_POOL_MAPPED only)
+    size_t mapping_size;     // Mapped image size (TC_POOL_MAPPED only)
+    tc_pool_item_fn init_fn;           // Runs after alloc (NULL = none)
+    tc_pool_item_fn destroy_fn;        // Runs before free/clear (NULL = none)
+    tc_pool_relocate_fn relocate_fn;   // Moves items on growth/swap-remove/compaction (NULL = memcpy)
+    tc_pool_batch_init_fn init_batch_fn; // Replaces init_fn in tc_pool_alloc_n (NULL = none)
+    void* hook_user_data;
+};
+
+// Pool creation parameters (zero-initialize, then fill what you need)
+typedef struct tc_pool_desc {
+    size_t item_size;          // Size of each item (required)
+    uint32_t initial_capacity; // Slots to preallocate
+    uint32_t flags;            // TC_POOL_* flags
+    uint32_t page_items;       // Items per page for TC_POOL_PAGED, rounded up to
+                               // a power of two (0 = TC_POOL_DEFAULT_PAGE_BYTES)
+    size_t alignment;          // Item alignment, power of two up to
+                               // TC_POOL_MAX_ALIGNMENT (0 = malloc default)
+    size_t stride;             // Bytes per item slot, a multiple of alignment
+                               // (0 = item_size rounded up to alignment). Use
+                               // alignment = stride = 64 to give every item its
+                               // own cache line.
+    tc_pool_item_fn init;              // Called for each allocated item
+    tc_pool_item_fn destroy;           // Called for each item freed, cleared or
+                                       // still live in tc_pool_free
+    tc_pool_relocate_fn relocate;      // Called when an item moves: growth, dense
+                                       // swap-remove, compaction (NULL = bytewise)
+    tc_pool_batch_init_fn init_batch;  // Batch constructor for tc_pool_alloc_n
+    void* hook_user_data;              // Passed to every hook
+} tc_pool_desc;
 
 // ============================================================================
 // Pool lifecycle
@@ -39,12 +148,47 @@ typedef struct tc_pool {
 // Initialize pool with given item size and initial capacity
 TCBASE_API bool tc_pool_init(tc_pool* pool, size_t item_size, uint32_t initial_capacity);
 
+// Initialize pool from a descriptor
+TCBASE_API bool tc_pool_init_ex(tc_pool* pool, const tc_pool_desc* desc);
+
 // Free pool resources
 TCBASE_API void tc_pool_free(tc_pool* pool);
 
 // Clear pool (mark all as free, bump generations)
 TCBASE_API void tc_pool_clear(tc_pool* pool);
 
+// Release memory not needed by live items (paged mode: frees empty pages,
+// including the spare page). No-op for other modes.
+TCBASE_API void tc_pool_trim(tc_pool* pool);
+
+// Move live items into a contiguous prefix and shrink the backing arrays.
+// If out_remap is not NULL it must hold capacity entries (capacity before the
+// call); out_remap[old_index] receives the new handle of each live item and
+// TC_HANDLE_INVALID for free slots. Old handles of moved items become stale.
+// Returns false if memory for a move could not be obtained (items moved so
+// far are reflected in out_remap, the pool is not shrunk).
+TCBASE_API bool tc_pool_compact(tc_pool* pool, tc_handle* out_remap);
+
+// ============================================================================
+// Snapshot / restore
+// ============================================================================
+//
+// The image is the pool's arrays written back to back with a versioned
+// header; only meaningful for POD items. Handles stay valid across a
+// save/load cycle. Hooks are not stored; restored pools have none.
+
+// Restore flags
+#define TC_POOL_RESTORE_COPY 0          // Read into owned, mutable arrays
+#define TC_POOL_RESTORE_MAP  (1u << 0)  // Map read-only and use in place
+
+// Write pool image to path
+TCBASE_API bool tc_pool_snapshot(const tc_pool* pool, const char* path);
+
+// Initialize pool from an image written by tc_pool_snapshot.
+// pool must not be initialized (or must have been freed).
+// Mapped pools are released with tc_pool_free as usual.
+TCBASE_API bool tc_pool_restore(tc_pool* pool, const char* path, uint32_t restore_flags);
+
 // ============================================================================
 // Pool operations
 // ============================================================================
@@ -63,7 +207,50 @@ TCBASE_API void* tc_pool_get(const tc_pool* pool, tc_handle h);
 
 // Get pointer to item by index (no validation - use carefully!)
 static inline void* tc_pool_get_unchecked(const tc_pool* pool, uint32_t index) {
-    return (char*)pool->data + index * pool->item_size;
+    if (pool->pages) {
+        uint32_t offset = index & ((1u << pool->page_shift) - 1);
+        return (char*)pool->pages[index >> pool->page_shift] + (size_t)offset * pool->item_stride;
+    }
+    if (pool->slot_to_dense) index = pool->slot_to_dense[index];
+    return (char*)pool->data + (size_t)index * pool->item_stride;
+}
+
+// ============================================================================
+// Batch operations
+// ============================================================================
+//
+// One library call per batch instead of per handle. Validity masks hold
+// one bit per handle (bit i % 64 of word i / 64), so callers pass
+// (n + 63) / 64 words.
+
+// Allocate n slots into out_handles; grows the pool at most once.
+// Returns number allocated; remaining entries are set to TC_HANDLE_INVALID.
+TCBASE_API uint32_t tc_pool_alloc_n(tc_pool* pool, uint32_t n, tc_handle* out_handles);
+
+// Free n handles, skipping invalid ones. Returns number freed.
+TCBASE_API uint32_t tc_pool_free_n(tc_pool* pool, const tc_handle* handles, uint32_t n);
+
+// Fill out_mask with validity bits. Returns number of valid handles.
+TCBASE_API uint32_t tc_pool_validate_many(const tc_pool* pool, const tc_handle* handles, uint32_t n,
+                                          uint64_t* out_mask);
+
+// Resolve handles to item pointers (NULL for invalid ones).
+// out_mask is optional. Returns number of valid handles.
+TCBASE_API uint32_t tc_pool_get_many(const tc_pool* pool, const tc_handle* handles, uint32_t n,
+                                     void** out_items, uint64_t* out_mask);
+
+// ============================================================================
+// Dense access (TC_POOL_DENSE only)
+// ============================================================================
+
+// Packed live items: tc_pool_count() items item_stride bytes apart, NULL if not dense
+static inline void* tc_pool_dense_items(const tc_pool* pool) {
+    return pool->dense_to_slot ? pool->data : NULL;
+}
+
+// Slot index of the item at given dense position
+static inline uint32_t tc_pool_dense_slot(const tc_pool* pool, uint32_t dense_index) {
+    return pool->dense_to_slot[dense_index];
 }
 
 // ============================================================================
@@ -74,9 +261,40 @@ static inline void* tc_pool_get_unchecked(const tc_pool* pool, uint32_t index) {
 // Return true to continue, false to stop
 typedef bool (*tc_pool_iter_fn)(uint32_t index, void* item, void* user_data);
 
-// Iterate over all occupied slots
+// Iterate over all occupied slots.
+// In dense mode walks the packed array (last to first), so freeing the
+// current item from the callback is safe.
 TCBASE_API void tc_pool_foreach(tc_pool* pool, tc_pool_iter_fn callback, void* user_data);
 
+// Chunk callback for parallel iteration. [begin, end) are dense positions
+// in dense mode (all live, see tc_pool_dense_items), otherwise slot indices
+// (check tc_pool_slot_occupied before touching an item).
+typedef void (*tc_pool_chunk_fn)(tc_pool* pool, uint32_t begin, uint32_t end, void* user_data);
+
+// Run callback over the pool range split into chunks on a shared worker pool.
+// The calling thread participates and the call returns when all chunks are done.
+// chunk_size 0 picks a size from the range; thread_count 0 uses all cores.
+// The pool must not be modified while this runs. If another parallel
+// iteration is already running, chunks run serially on the calling thread.
+TCBASE_API void tc_pool_parallel_foreach(tc_pool* pool, tc_pool_chunk_fn callback, void* user_data,
+                                         uint32_t chunk_size, uint32_t thread_count);
+
+// Check whether slot index holds a live item (index must be < capacity)
+static inline bool tc_pool_slot_occupied(const tc_pool* pool, uint32_t index) {
+    return (pool->occupied[index / TC_POOL_WORD_BITS] >> (index % TC_POOL_WORD_BITS)) & 1;
+}
+
+// Index of the lowest set bit (x must not be 0)
+static inline uint32_t tc_pool_ctz64(uint64_t x) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long bit;
+    _BitScanForward64(&bit, x);
+    return (uint32_t)bit;
+#else
+    return (uint32_t)__builtin_ctzll(x);
+#endif
+}
+
 // Get count of occupied slots
 static inline uint32_t tc_pool_count(const tc_pool* pool) {
     return pool ? pool->count : 0;
@@ -0,0 +1,105 @@
+// tc_resource_loader.h - Asynchronous resource loading by UUID
+// Requests insert a pending entry immediately; decoding runs on worker
+// threads in priority order and the result replaces the placeholder.
+#pragma once
+
+#include <tcbase/tcbase_api.h>
+#include <tcbase/tc_resource_map.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// Types
+// ============================================================================
+
+typedef struct tc_resource_loader tc_resource_loader;
+
+typedef enum tc_load_state {
+    TC_LOAD_NONE = 0,      // Never requested (or removed)
+    TC_LOAD_PENDING = 1,   // Queued or decoding
+    TC_LOAD_READY = 2,
+    TC_LOAD_FAILED = 3,    // Decoder returned NULL
+} tc_load_state;
+
+// Produce the resource for uuid. Runs on a worker thread (or on a thread
+// blocked in tc_resource_loader_wait). Return NULL on failure.
+typedef void* (*tc_resource_decode_fn)(const char* uuid, void* user_data);
+
+// Completion notification. resource is NULL unless state is TC_LOAD_READY.
+typedef void (*tc_resource_loaded_fn)(
+    const char* uuid,
+    void* resource,
+    tc_load_state state,
+    void* user_data
+);
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+// Create a loader with its own worker threads (worker_count 0 picks one
+// per hardware thread minus one, at least one). destructor is called for
+// loaded resources on remove and free (can be NULL).
+TCBASE_API tc_resource_loader* tc_resource_loader_new(
+    tc_resource_decode_fn decode,
+    tc_resource_free_fn destructor,
+    void* user_data,
+    uint32_t worker_count
+);
+
+// Stop workers (decodes in progress finish first), drop queued requests
+// and undelivered callbacks, destroy loaded resources.
+TCBASE_API void tc_resource_loader_free(tc_resource_loader* loader);
+
+// ============================================================================
+// Requests
+// ============================================================================
+
+// Request uuid at the given priority (higher runs first). Concurrent
+// requests for the same uuid share one decode; a higher priority on a
+// pending request moves it up the queue. callback (can be NULL) is
+// queued for tc_resource_loader_dispatch once the entry completes, or
+// right away if it already has. Returns the entry state after the call.
+TCBASE_API tc_load_state tc_resource_loader_request(
+    tc_resource_loader* loader,
+    const char* uuid,
+    int32_t priority,
+    tc_resource_loaded_fn callback,
+    void* callback_user_data
+);
+
+// Run completion callbacks delivered so far on the calling thread.
+// Call it from the thread that removes entries, so a callback never sees
+// a resource that is being destroyed. Returns the number of callbacks run.
+TCBASE_API size_t tc_resource_loader_dispatch(tc_resource_loader* loader);
+
+// Remove an entry. A queued decode is cancelled; a running one finishes
+// and its result is destroyed. Pending callbacks for it are dropped.
+// Returns false if uuid is unknown.
+TCBASE_API bool tc_resource_loader_remove(tc_resource_loader* loader, const char* uuid);
+
+// ============================================================================
+// Queries (thread-safe)
+// ============================================================================
+
+TCBASE_API tc_load_state tc_resource_loader_state(tc_resource_loader* loader, const char* uuid);
+
+// Loaded resource, or NULL while pending, failed or unknown
+TCBASE_API void* tc_resource_loader_get(tc_resource_loader* loader, const char* uuid);
+
+// Block until uuid is loaded. A request still waiting in the queue is
+// decoded on the calling thread instead of waiting for a worker.
+// Returns NULL if uuid is unknown, failed or removed meanwhile.
+TCBASE_API void* tc_resource_loader_wait(tc_resource_loader* loader, const char* uuid);
+
+// Number of requests queued or decoding
+TCBASE_API size_t tc_resource_loader_pending(tc_resource_loader* loader);
+
+#ifdef __cplusplus
+}
+#endif
@@ -57,13 +57,80 @@ TCBASE_API bool tc_resource_map_contains(const tc_resource_map* map, const char*
 // Get number of resources
 TCBASE_API size_t tc_resource_map_count(const tc_resource_map* map);
 
+// ============================================================================
+// Bulk operations
+// ============================================================================
+
+// Make room for count resources in total, so adding up to that many does
+// not rehash. Returns false on allocation failure
+TCBASE_API bool tc_resource_map_reserve(tc_resource_map* map, size_t count);
+
+// Add n resources from parallel arrays (resources may be NULL for all-NULL
+// values). Rehashes at most once. Duplicate UUIDs are skipped.
+// Returns the number added
+TCBASE_API size_t tc_resource_map_add_many(
+    tc_resource_map* map,
+    const char* const* uuids,
+    void* const* resources,
+    size_t n
+);
+
+// ============================================================================
+// Precomputed hashes
+// ============================================================================
+//
+// Entries keep the 64-bit hash of their key, and probes compare it before
+// touching key bytes. Callers that look up the same UUID repeatedly can hash
+// it once with tc_resource_map_hash and use the *_hashed variants.
+// The hash must be tc_resource_map_hash(uuid).
+
+// Hash used for map keys (FNV-1a, 64-bit)
+TCBASE_API uint64_t tc_resource_map_hash(const char* uuid);
+
+TCBASE_API bool tc_resource_map_add_hashed(tc_resource_map* map, const char* uuid, uint64_t hash, void* resource);
+TCBASE_API void* tc_resource_map_get_hashed(const tc_resource_map* map, const char* uuid, uint64_t hash);
+TCBASE_API bool tc_resource_map_remove_hashed(tc_resource_map* map, const char* uuid, uint64_t hash);
+TCBASE_API bool tc_resource_map_contains_hashed(const tc_resource_map* map, const char* uuid, uint64_t hash);
+
+// ============================================================================
+// Reference counting and memory budget
+// ============================================================================
+//
+// With a budget set, the map works as a bounded cache. Each entry carries
+// a byte cost (0 by default) and a refcount. Entries nobody holds are kept
+// in least-recently-used order; adding or releasing an entry makes it the
+// most recent. Whenever the total cost exceeds the budget, unreferenced
+// entries are evicted oldest first and their destructor runs, until the
+// budget is met or no unreferenced entry with a cost is left. This can
+// include an entry that was just added or released. Referenced entries are
+// never evicted, but tc_resource_map_remove still removes them.
+
+// Get resource and take a reference; NULL if not found
+TCBASE_API void* tc_resource_map_acquire(tc_resource_map* map, const char* uuid);
+
+// Drop a reference taken by acquire. Returns false if not found or not held
+TCBASE_API bool tc_resource_map_release(tc_resource_map* map, const char* uuid);
+
+// Current reference count (0 if not found)
+TCBASE_API uint32_t tc_resource_map_refcount(const tc_resource_map* map, const char* uuid);
+
+// Set the byte cost of an entry. Returns false if not found
+TCBASE_API bool tc_resource_map_set_cost(tc_resource_map* map, const char* uuid, size_t cost);
+
+// Set the memory budget in bytes (0 = unlimited, the default)
+TCBASE_API void tc_resource_map_set_budget(tc_resource_map* map, size_t budget);
+
+// Sum of entry costs
+TCBASE_API size_t tc_resource_map_total_cost(const tc_resource_map* map);
+
 // ============================================================================
 // Iteration
 // ============================================================================
 
-// Iterate over all resources
+// Iterate over all resources in insertion order
 // Callback receives uuid, resource pointer, and user_data
 // Return false from callback to stop iteration
+// The callback may remove entries but must not add them
 TCBASE_API void tc_resource_map_foreach(
     tc_resource_map* map,
     tc_resource_iter_fn callback,
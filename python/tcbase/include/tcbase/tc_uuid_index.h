@@ -0,0 +1,92 @@
+// tc_uuid_index.h - Persistent memory-mapped UUID hash index
+#pragma once
+
+#include <tcbase/tcbase_api.h>
+#include <tcbase/tc_resource_map.h>
+#include <tcbase/tc_uuid_map.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// UUID index - read-only UUID -> uint64 table queried in place
+// ============================================================================
+//
+// An index file is an open-addressed hash table that is mapped and probed
+// directly. Opening does no parsing and no inserting, so the cost is
+// independent of the entry count. Values are opaque 64-bit numbers, for
+// example offsets into an asset table. The nil UUID cannot be a key.
+
+typedef struct tc_uuid_index tc_uuid_index;
+
+// Write an index of n entries to path. A later duplicate key overrides an
+// earlier one. Returns false on I/O error or a nil key
+TCBASE_API bool tc_uuid_index_write(const char* path, const tc_uuid* keys, const uint64_t* values, size_t n);
+
+// Map an index file. Returns NULL if it is missing or invalid
+TCBASE_API tc_uuid_index* tc_uuid_index_open(const char* path);
+
+TCBASE_API void tc_uuid_index_close(tc_uuid_index* index);
+
+// Look up uuid; on success stores its value in out_value
+TCBASE_API bool tc_uuid_index_lookup(const tc_uuid_index* index, tc_uuid uuid, uint64_t* out_value);
+
+// Number of entries
+TCBASE_API size_t tc_uuid_index_count(const tc_uuid_index* index);
+
+// ============================================================================
+// Layered map - mutable tc_resource_map over a read-only index
+// ============================================================================
+//
+// Lookups check the overlay (a tc_resource_map keyed by the canonical
+// tc_uuid_format string) first, then the base index. Keys that do not
+// parse as UUIDs are rejected. A base hit is materialized through the load
+// callback and cached in the overlay. Adding a key puts it in the overlay.
+// Removing a base key records a whiteout, so the base is never written.
+
+typedef struct tc_layered_map tc_layered_map;
+
+// Create the resource for a base entry (NULL = treat as missing)
+typedef void* (*tc_layered_load_fn)(const char* uuid, uint64_t value, void* user_data);
+
+// base must outlive the layered map. destructor runs for overlay resources
+// on remove and free (can be NULL)
+TCBASE_API tc_layered_map* tc_layered_map_new(
+    const tc_uuid_index* base,
+    tc_resource_free_fn destructor,
+    tc_layered_load_fn load,
+    void* user_data
+);
+
+TCBASE_API void tc_layered_map_free(tc_layered_map* map);
+
+// Returns false if uuid is already present in either layer, does not
+// parse, or resource is NULL
+TCBASE_API bool tc_layered_map_add(tc_layered_map* map, const char* uuid, void* resource);
+
+// Get resource, loading it from the base on first access; NULL if not found
+TCBASE_API void* tc_layered_map_get(tc_layered_map* map, const char* uuid);
+
+// Remove from the overlay and hide the base entry. Returns true if removed
+TCBASE_API bool tc_layered_map_remove(tc_layered_map* map, const char* uuid);
+
+// True if uuid is present in either layer (does not load)
+TCBASE_API bool tc_layered_map_contains(const tc_layered_map* map, const char* uuid);
+
+// Entries visible through both layers
+TCBASE_API size_t tc_layered_map_count(const tc_layered_map* map);
+
+// Iterate over resources that have been added or loaded so far
+TCBASE_API void tc_layered_map_foreach_loaded(
+    tc_layered_map* map,
+    tc_resource_iter_fn callback,
+    void* user_data
+);
+
+#ifdef __cplusplus
+}
+#endif
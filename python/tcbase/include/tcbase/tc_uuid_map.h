@@ -0,0 +1,84 @@
+// tc_uuid_map.h - Resource map keyed by binary 128-bit UUIDs
+#pragma once
+
+#include <tcbase/tcbase_api.h>
+#include <tcbase/tc_resource_map.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// Binary UUID
+// ============================================================================
+
+// 128-bit UUID. hi holds the first 16 hex digits of the text form, lo the last 16.
+typedef struct tc_uuid {
+    uint64_t hi;
+    uint64_t lo;
+} tc_uuid;
+
+// Length of the text form "xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx" plus terminator
+#define TC_UUID_STRING_SIZE 37
+
+// Parse hyphenated (36 chars) or plain (32 chars) hex, any case.
+// Returns false on malformed input.
+TCBASE_API bool tc_uuid_parse(const char* str, tc_uuid* out);
+
+// Write the lowercase hyphenated form to out
+TCBASE_API void tc_uuid_format(tc_uuid id, char out[TC_UUID_STRING_SIZE]);
+
+static inline bool tc_uuid_eq(tc_uuid a, tc_uuid b) {
+    return a.hi == b.hi && a.lo == b.lo;
+}
+
+static inline bool tc_uuid_is_nil(tc_uuid id) {
+    return id.hi == 0 && id.lo == 0;
+}
+
+// ============================================================================
+// UUID map - stores void* resources by binary UUID
+// ============================================================================
+//
+// Same semantics as tc_resource_map, but keys live inline in the table:
+// no per-key allocation, and a probe compares two 64-bit words.
+// Text keys are parsed once with tc_uuid_parse.
+
+typedef struct tc_uuid_map tc_uuid_map;
+
+// Iterator callback: return true to continue, false to stop
+typedef bool (*tc_uuid_iter_fn)(tc_uuid uuid, void* resource, void* user_data);
+
+// Create a new map; destructor is called when resources are removed or the map is destroyed (can be NULL)
+TCBASE_API tc_uuid_map* tc_uuid_map_new(tc_resource_free_fn destructor);
+
+// Destroy map and all resources (calls destructor for each)
+TCBASE_API void tc_uuid_map_free(tc_uuid_map* map);
+
+// Clear all resources (calls destructor for each)
+TCBASE_API void tc_uuid_map_clear(tc_uuid_map* map);
+
+// Add resource with given UUID. Returns false if UUID already exists
+TCBASE_API bool tc_uuid_map_add(tc_uuid_map* map, tc_uuid uuid, void* resource);
+
+// Get resource by UUID, returns NULL if not found
+TCBASE_API void* tc_uuid_map_get(const tc_uuid_map* map, tc_uuid uuid);
+
+// Remove resource by UUID (calls destructor). Returns true if removed
+TCBASE_API bool tc_uuid_map_remove(tc_uuid_map* map, tc_uuid uuid);
+
+// Check if UUID exists
+TCBASE_API bool tc_uuid_map_contains(const tc_uuid_map* map, tc_uuid uuid);
+
+// Get number of resources
+TCBASE_API size_t tc_uuid_map_count(const tc_uuid_map* map);
+
+// Iterate over all resources; return false from callback to stop
+TCBASE_API void tc_uuid_map_foreach(tc_uuid_map* map, tc_uuid_iter_fn callback, void* user_data);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,21 +1,85 @@
 // tgfx_intern_string.h - Shared string interning utility
-// Returns pointer valid for library lifetime. Thread-unsafe (call from main thread).
+// Returns pointer valid for library lifetime. Lookups of already interned
+// strings are lock-free; new strings are inserted under a lock, so any
+// thread may intern.
 #pragma once
 
 #include <tcbase/tcbase_api.h>
+#include <stddef.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+// ============================================================================
+// Strings
+// ============================================================================
+
 // Intern a string. Returns a pointer to the interned copy.
 // The returned pointer is valid for the library's lifetime.
 // Returns NULL if s is NULL or allocation fails.
 TCBASE_API const char* tgfx_intern_string(const char* s);
 
-// Free all interned strings. Call at shutdown.
+// Intern len bytes of s (need not be NUL-terminated). The copy is.
+TCBASE_API const char* tgfx_intern_string_n(const char* s, size_t len);
+
+// Free all interned strings. Call at shutdown, with no other thread interning.
+// Pointers and atoms obtained earlier become invalid.
 TCBASE_API void tgfx_intern_cleanup(void);
 
+// ============================================================================
+// Hash
+// ============================================================================
+//
+// FNV-1a over the string bytes. The step is constexpr in C++, so
+// tc::intern_hash can evaluate it at compile time (see tgfx_intern_string.hpp).
+
+#define TGFX_INTERN_HASH_SEED 2166136261u
+#define TGFX_INTERN_HASH_PRIME 16777619u
+
+#ifdef __cplusplus
+#define TGFX_INTERN_HASH_STEP_FN static constexpr
+#else
+#define TGFX_INTERN_HASH_STEP_FN static inline
+#endif
+
+TGFX_INTERN_HASH_STEP_FN uint32_t tgfx_intern_hash_step(uint32_t hash, unsigned char c) {
+    return (hash ^ c) * TGFX_INTERN_HASH_PRIME;
+}
+
+TCBASE_API uint32_t tgfx_intern_hash(const char* s, size_t len);
+
+// ============================================================================
+// Atoms
+// ============================================================================
+//
+// Each interned string has a dense 32-bit id, assigned in interning order
+// from 1. Atom -> string is an array lookup.
+
+typedef uint32_t tgfx_atom;
+
+#define TGFX_ATOM_NONE 0u
+
+// Atom for s, interning it if needed. TGFX_ATOM_NONE on NULL or failure.
+TCBASE_API tgfx_atom tgfx_atom_intern(const char* s);
+TCBASE_API tgfx_atom tgfx_atom_intern_n(const char* s, size_t len);
+
+// Same with hash = tgfx_intern_hash(s, len), e.g. computed at compile time
+TCBASE_API tgfx_atom tgfx_atom_intern_hashed(const char* s, size_t len, uint32_t hash);
+
+// Atom of a pointer returned by tgfx_intern_string*. O(1).
+TCBASE_API tgfx_atom tgfx_atom_of_interned(const char* interned);
+
+// Interned string for atom, or NULL if atom is not assigned
+TCBASE_API const char* tgfx_atom_string(tgfx_atom atom);
+
+// Length of the atom's string (0 if not assigned)
+TCBASE_API size_t tgfx_atom_length(tgfx_atom atom);
+
+// Number of atoms assigned so far; valid atoms are 1..count
+TCBASE_API tgfx_atom tgfx_atom_count(void);
+
 #ifdef __cplusplus
 }
 #endif
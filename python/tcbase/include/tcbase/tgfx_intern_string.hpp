@@ -0,0 +1,55 @@
+// tgfx_intern_string.hpp - C++ helpers over tgfx_intern_string
+#pragma once
+
+#include <tcbase/tgfx_intern_string.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace tc {
+
+// Same value as tgfx_intern_hash, usable in constant expressions
+constexpr uint32_t intern_hash(std::string_view s) {
+    uint32_t hash = TGFX_INTERN_HASH_SEED;
+    for (char c : s) {
+        hash = tgfx_intern_hash_step(hash, static_cast<unsigned char>(c));
+    }
+    return hash;
+}
+
+// A string literal hashed at compile time.
+// Usage:
+//   static const tgfx_atom u_model = tc::atom("u_model");
+class InternName {
+public:
+    template<size_t N>
+    consteval InternName(const char (&s)[N])
+        : str_(s), len_(N - 1), hash_(intern_hash(std::string_view(s, N - 1))) {}
+
+    constexpr const char* data() const { return str_; }
+    constexpr size_t size() const { return len_; }
+    constexpr uint32_t hash() const { return hash_; }
+
+private:
+    const char* str_;
+    size_t len_;
+    uint32_t hash_;
+};
+
+// Atom for a literal; no hashing at runtime
+inline tgfx_atom atom(InternName name) {
+    return tgfx_atom_intern_hashed(name.data(), name.size(), name.hash());
+}
+
+// Atom for a runtime string
+inline tgfx_atom intern_atom(std::string_view s) {
+    return tgfx_atom_intern_n(s.data(), s.size());
+}
+
+inline std::string_view atom_view(tgfx_atom a) {
+    const char* s = tgfx_atom_string(a);
+    return s ? std::string_view(s, tgfx_atom_length(a)) : std::string_view();
+}
+
+} // namespace tc
@@ -0,0 +1,98 @@
+// tc_epoch.cpp - Epoch-based reclamation for lock-free readers
+#include "tc_epoch.hpp"
+
+namespace tc_epoch {
+
+// ============================================================================
+// Reader records
+// ============================================================================
+
+namespace {
+
+constexpr uint64_t IDLE = UINT64_MAX;
+
+// One per thread that ever read; recycled when the thread exits, never freed
+struct alignas(64) Record {
+    std::atomic<uint64_t> epoch{IDLE};
+    std::atomic<bool> in_use{false};
+    Record* next = nullptr;
+};
+
+std::atomic<Record*> g_records{nullptr};
+std::atomic<uint64_t> g_epoch{1};
+
+Record* acquire_record() {
+    for (Record* r = g_records.load(std::memory_order_acquire); r; r = r->next) {
+        bool expected = false;
+        if (!r->in_use.load(std::memory_order_relaxed) &&
+            r->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+            return r;
+        }
+    }
+
+    Record* r = new Record;
+    r->in_use.store(true, std::memory_order_relaxed);
+    Record* head = g_records.load(std::memory_order_relaxed);
+    do {
+        r->next = head;
+    } while (!g_records.compare_exchange_weak(head, r, std::memory_order_release, std::memory_order_relaxed));
+    return r;
+}
+
+struct ThreadState {
+    Record* record = nullptr;
+    uint32_t depth = 0;
+
+    ~ThreadState() {
+        if (!record) return;
+        record->epoch.store(IDLE, std::memory_order_release);
+        record->in_use.store(false, std::memory_order_release);
+    }
+};
+
+thread_local ThreadState t_state;
+
+} // namespace
+
+// ============================================================================
+// Readers
+// ============================================================================
+
+void enter() {
+    ThreadState& ts = t_state;
+    if (ts.depth++ > 0) return;
+    if (!ts.record) ts.record = acquire_record();
+
+    // A stale epoch only delays reclamation. The fence orders the
+    // announcement before any load of shared nodes.
+    ts.record->epoch.store(g_epoch.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+void exit() {
+    ThreadState& ts = t_state;
+    if (--ts.depth > 0) return;
+    ts.record->epoch.store(IDLE, std::memory_order_release);
+}
+
+// ============================================================================
+// Writers
+// ============================================================================
+
+uint64_t advance() {
+    // Readers that announce the new epoch are ordered after the unlink
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    return g_epoch.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t min_active() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    uint64_t oldest = IDLE;
+    for (Record* r = g_records.load(std::memory_order_acquire); r; r = r->next) {
+        uint64_t e = r->epoch.load(std::memory_order_acquire);
+        if (e < oldest) oldest = e;
+    }
+    return oldest;
+}
+
+} // namespace tc_epoch
@@ -0,0 +1,76 @@
+// tc_epoch.hpp - Epoch-based reclamation for lock-free readers
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+// Readers bracket every access to shared nodes with a Guard. Writers unlink
+// a node, then retire it; retired memory is freed only once every reader
+// that could still see it has left its critical section.
+//
+// Reader cost is one store and one fence on a per-thread cache line, so
+// readers never contend with each other. Guards nest.
+
+namespace tc_epoch {
+
+// Enter/leave a read-side critical section (nestable, per thread)
+void enter();
+void exit();
+
+struct Guard {
+    Guard() { enter(); }
+    ~Guard() { exit(); }
+    Guard(const Guard&) = delete;
+    Guard& operator=(const Guard&) = delete;
+};
+
+// Call after unlinking; returns the epoch to tag retired memory with
+uint64_t advance();
+
+// Oldest epoch a reader may still be in (UINT64_MAX if none)
+uint64_t min_active();
+
+// Writer-side list of retired allocations. Not thread-safe: guard it with
+// the structure's writer lock.
+class RetireList {
+public:
+    using free_fn = void (*)(void*);
+
+    ~RetireList() { reclaim_all(); }
+
+    void retire(void* ptr, free_fn fn) {
+        items_.push_back({ptr, fn, advance()});
+    }
+
+    // Free everything no reader can reach any more
+    void reclaim() {
+        if (items_.empty()) return;
+        uint64_t oldest = min_active();
+        size_t kept = 0;
+        for (size_t i = 0; i < items_.size(); i++) {
+            if (items_[i].epoch < oldest) {
+                items_[i].fn(items_[i].ptr);
+            } else {
+                items_[kept++] = items_[i];
+            }
+        }
+        items_.resize(kept);
+    }
+
+    // Free everything; only when no reader can be active
+    void reclaim_all() {
+        for (const Item& item : items_) item.fn(item.ptr);
+        items_.clear();
+    }
+
+private:
+    struct Item {
+        void* ptr;
+        free_fn fn;
+        uint64_t epoch;
+    };
+    std::vector<Item> items_;
+};
+
+} // namespace tc_epoch
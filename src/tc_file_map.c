@@ -0,0 +1,68 @@
+// tc_file_map.c - Read-only whole-file memory mapping
+#include "tc_file_map.h"
+#include <tcbase/tc_log.h>
+#include <stdint.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+void* tc_file_map_readonly(const char* path, size_t* out_size) {
+    void* base = NULL;
+    uint64_t size = 0;
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        tc_log(TC_LOG_ERROR, "cannot open '%s'", path);
+        return NULL;
+    }
+    LARGE_INTEGER file_size;
+    HANDLE mapping = NULL;
+    if (GetFileSizeEx(file, &file_size) && file_size.QuadPart > 0) {
+        size = (uint64_t)file_size.QuadPart;
+        mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    }
+    if (mapping) {
+        base = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+    }
+    CloseHandle(file);
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        tc_log(TC_LOG_ERROR, "cannot open '%s'", path);
+        return NULL;
+    }
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        size = (uint64_t)st.st_size;
+        base = mmap(NULL, (size_t)size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (base == MAP_FAILED) base = NULL;
+    }
+    close(fd);
+#endif
+
+    if (!base) {
+        tc_log(TC_LOG_ERROR, "failed to map '%s'", path);
+        return NULL;
+    }
+    *out_size = (size_t)size;
+    return base;
+}
+
+void tc_file_unmap(void* base, size_t size) {
+    if (!base) return;
+#ifdef _WIN32
+    (void)size;
+    UnmapViewOfFile(base);
+#else
+    munmap(base, size);
+#endif
+}
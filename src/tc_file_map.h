@@ -0,0 +1,11 @@
+// tc_file_map.h - Read-only whole-file memory mapping
+#pragma once
+
+#include <stddef.h>
+
+// Map a file read-only. Returns NULL with an error logged if the file
+// cannot be opened or mapped, or is empty.
+void* tc_file_map_readonly(const char* path, size_t* out_size);
+
+// Release a mapping from tc_file_map_readonly
+void tc_file_unmap(void* base, size_t size);
@@ -0,0 +1,399 @@
+// tc_log.cpp - Shared logging: synchronous delivery and async ring-buffer backend
+#include <tcbase/tc_log.h>
+#include <tcbase/tc_log_binary.h>
+#include "tc_log_internal.h"
+
+#include <atomic>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <thread>
+
+namespace tc {
+namespace detail {
+// NEVER change this value. If you need to silence logs, remove the tc_log_* calls.
+std::atomic<int> log_min_level{TC_LOG_DEBUG};
+} // namespace detail
+} // namespace tc
+
+namespace {
+
+constexpr size_t MESSAGE_MAX = 4096;
+
+// ============================================================================
+// Async ring
+// ============================================================================
+//
+// Multi-producer, single-consumer byte ring of variable-length records.
+// A producer reserves space by advancing head with CAS, writes the
+// payload, then publishes the record by storing its size into the header.
+// The writer consumes records in order, zeroes them and advances tail.
+// A record that would straddle the end is preceded by a padding record.
+
+struct RecordHeader {
+    uint32_t size;      // Whole record incl. header, 0 until committed
+    uint32_t level;     // PAD_LEVEL for padding
+    uint32_t len;       // Message length, so sinks get it without strlen
+    uint32_t flags;
+};
+
+// The producer had deferred records pending: deliver them first
+constexpr uint32_t RECORD_AFTER_BINARY = 1;
+
+constexpr uint32_t PAD_LEVEL = 0xFFFFFFFFu;
+constexpr size_t RECORD_ALIGN = 8;
+
+inline size_t record_size(size_t len) {
+    return (sizeof(RecordHeader) + len + 1 + RECORD_ALIGN - 1) & ~(RECORD_ALIGN - 1);
+}
+
+struct AsyncLog {
+    char* buffer = nullptr;
+    size_t size = 0;                         // Power of two
+    tc_log_overflow policy = TC_LOG_OVERFLOW_BLOCK;
+
+    std::atomic<uint64_t> head{0};           // Next byte to reserve
+    std::atomic<uint64_t> tail{0};           // Next byte to consume; also "written up to"
+    std::atomic<uint32_t> wake{0};           // Bumped on commit to wake the writer
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> unreported{0};     // Dropped since the last notice
+
+    std::atomic<bool> enabled{false};
+    std::atomic<uint32_t> producers{0};      // Callers inside the async path
+    std::atomic<bool> stop{false};
+    std::thread writer;
+    std::mutex control_mutex;                // Serializes start/stop
+    bool atexit_registered = false;
+};
+
+AsyncLog g_async;
+
+// Set on the writer thread: logging from a callback there must not wait on itself
+thread_local bool t_is_writer = false;
+
+// End of this thread's last record in the ring
+thread_local uint64_t t_ring_end = 0;
+
+std::atomic_ref<uint32_t> header_size(RecordHeader* h) {
+    return std::atomic_ref<uint32_t>(h->size);
+}
+
+RecordHeader* header_at(uint64_t pos) {
+    return reinterpret_cast<RecordHeader*>(g_async.buffer + (pos & (g_async.size - 1)));
+}
+
+// Reserve need bytes (plus padding to the end if they would straddle it).
+// Returns the record position, or UINT64_MAX if the ring is full.
+uint64_t ring_reserve(size_t need) {
+    uint64_t h = g_async.head.load(std::memory_order_relaxed);
+    for (;;) {
+        size_t pos = size_t(h & (g_async.size - 1));
+        size_t to_end = g_async.size - pos;
+        size_t pad = to_end < need ? to_end : 0;
+
+        uint64_t t = g_async.tail.load(std::memory_order_acquire);
+        if (h + pad + need - t > g_async.size) return UINT64_MAX;
+
+        if (g_async.head.compare_exchange_weak(h, h + pad + need, std::memory_order_relaxed)) {
+            if (pad) {
+                RecordHeader* p = header_at(h);
+                p->level = PAD_LEVEL;
+                header_size(p).store(uint32_t(pad), std::memory_order_release);
+            }
+            return h + pad;
+        }
+    }
+}
+
+void wake_writer() {
+    g_async.wake.fetch_add(1, std::memory_order_release);
+    g_async.wake.notify_one();
+}
+
+// Copy a formatted message into the ring. Returns false if it was dropped.
+bool ring_push(tc_log_level level, const char* message, size_t len, uint32_t flags) {
+    size_t max_len = g_async.size / 4 - sizeof(RecordHeader) - 1;
+    if (len > max_len) len = max_len;
+    size_t need = record_size(len);
+
+    uint64_t pos;
+    while ((pos = ring_reserve(need)) == UINT64_MAX) {
+        if (g_async.policy != TC_LOG_OVERFLOW_BLOCK) {
+            g_async.dropped.fetch_add(1, std::memory_order_relaxed);
+            if (g_async.policy == TC_LOG_OVERFLOW_COUNT) {
+                g_async.unreported.fetch_add(1, std::memory_order_relaxed);
+            }
+            return false;
+        }
+        wake_writer();
+        std::this_thread::yield();
+    }
+
+    RecordHeader* rec = header_at(pos);
+    rec->level = uint32_t(level);
+    rec->len = uint32_t(len);
+    rec->flags = flags;
+    char* text = reinterpret_cast<char*>(rec + 1);
+    memcpy(text, message, len);
+    text[len] = '\0';
+    header_size(rec).store(uint32_t(need), std::memory_order_release);
+    t_ring_end = pos + need;
+    wake_writer();
+    return true;
+}
+
+// Writer side: emit every committed record. Returns true if any was consumed.
+bool ring_drain() {
+    uint64_t t = g_async.tail.load(std::memory_order_relaxed);
+    uint64_t start = t;
+
+    for (;;) {
+        RecordHeader* rec = header_at(t);
+        uint32_t size = header_size(rec).load(std::memory_order_acquire);
+        if (size == 0) break;     // Not reserved yet, or reserved but not committed
+
+        if (rec->level != PAD_LEVEL) {
+            if (rec->flags & RECORD_AFTER_BINARY) tc_log_binary_drain();
+            const char* text = reinterpret_cast<const char*>(rec + 1);
+            tc_log_sinks_write(tc_log_level(rec->level), text, rec->len);
+        }
+        // Zero before releasing, so a later header here reads as uncommitted
+        memset(rec, 0, size);
+        t += size;
+        g_async.tail.store(t, std::memory_order_release);
+    }
+
+    if (t == start) return false;
+    tc_log_sinks_flush();
+    g_async.tail.notify_all();
+    return true;
+}
+
+void report_dropped() {
+    uint64_t n = g_async.unreported.exchange(0, std::memory_order_relaxed);
+    if (n) {
+        char notice[64];
+        int len = snprintf(notice, sizeof(notice), "tc_log: %llu messages dropped", (unsigned long long)n);
+        tc_log_sinks_write(TC_LOG_WARN, notice, size_t(len));
+        tc_log_sinks_flush();
+    }
+}
+
+void writer_loop() {
+    t_is_writer = true;
+    for (;;) {
+        uint32_t seen = g_async.wake.load(std::memory_order_acquire);
+        tc_log_binary_drain();
+        bool progressed = ring_drain();
+        report_dropped();
+        if (g_async.stop.load(std::memory_order_acquire)) {
+            if (!progressed && g_async.tail.load() == g_async.head.load()) return;
+            continue;
+        }
+        if (!progressed) {
+            g_async.wake.wait(seen, std::memory_order_acquire);
+        }
+    }
+}
+
+// Block until everything reserved so far has been written
+void wait_written() {
+    uint64_t target = g_async.head.load(std::memory_order_acquire);
+    uint64_t t = g_async.tail.load(std::memory_order_acquire);
+    while (t < target) {
+        wake_writer();
+        g_async.tail.wait(t, std::memory_order_acquire);
+        t = g_async.tail.load(std::memory_order_acquire);
+    }
+}
+
+void stop_at_exit() {
+    tc_log_stop_async();
+}
+
+// Deliver a formatted message through the async ring or synchronously
+void dispatch(tc_log_level level, const char* message, size_t len) {
+    bool queued = tc_log_deliver(level, message, len);
+    if (level >= TC_LOG_ERROR) {
+        // Errors often precede a crash: do not leave them in the ring
+        tc_log_flush();
+    } else if (!queued) {
+        tc_log_sinks_flush();
+    }
+}
+
+void log_v(tc_log_level level, const char* format, va_list args) {
+    if (!tc::log_enabled(level)) {
+        return;
+    }
+
+    char buffer[MESSAGE_MAX];
+    int len = vsnprintf(buffer, sizeof(buffer), format, args);
+    if (len < 0) return;
+    if (size_t(len) >= sizeof(buffer)) len = int(sizeof(buffer) - 1);
+
+    dispatch(level, buffer, size_t(len));
+}
+
+} // namespace
+
+// ============================================================================
+// Internal hooks
+// ============================================================================
+
+bool tc_log_deliver(tc_log_level level, const char* message, size_t len) {
+    g_async.producers.fetch_add(1, std::memory_order_acq_rel);
+    if (g_async.enabled.load(std::memory_order_acquire) && !t_is_writer) {
+        ring_push(level, message, len, tc_log_binary_pending() ? RECORD_AFTER_BINARY : 0);
+        g_async.producers.fetch_sub(1, std::memory_order_release);
+        return true;
+    }
+    g_async.producers.fetch_sub(1, std::memory_order_release);
+
+    if (tc_log_binary_pending()) tc_log_binary_drain();
+    tc_log_sinks_write(level, message, len);
+    return false;
+}
+
+void tc_log_wake_writer(void) {
+    if (g_async.enabled.load(std::memory_order_relaxed)) {
+        wake_writer();
+    }
+}
+
+uint64_t tc_log_ring_written(void) {
+    return g_async.tail.load(std::memory_order_acquire);
+}
+
+uint64_t tc_log_thread_ring_end(void) {
+    return t_ring_end;
+}
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+void tc_log_set_level(tc_log_level min_level) {
+    tc::detail::log_min_level.store(min_level, std::memory_order_relaxed);
+}
+
+bool tc_log_enabled(tc_log_level level) {
+    return tc::log_enabled(level);
+}
+
+// ============================================================================
+// Async mode
+// ============================================================================
+
+bool tc_log_start_async(size_t ring_bytes, tc_log_overflow policy) {
+    std::lock_guard<std::mutex> lock(g_async.control_mutex);
+    if (g_async.enabled.load()) return true;
+
+    size_t size = 4096;
+    while (size < ring_bytes) size *= 2;
+
+    if (g_async.size != size) {
+        char* buffer = static_cast<char*>(calloc(1, size));
+        if (!buffer) {
+            tc_log(TC_LOG_ERROR, "tc_log: failed to allocate %zu byte ring", size);
+            return false;
+        }
+        free(g_async.buffer);
+        g_async.buffer = buffer;
+        g_async.size = size;
+    }
+    g_async.policy = policy;
+    g_async.stop.store(false);
+
+    try {
+        g_async.writer = std::thread(writer_loop);
+    } catch (...) {
+        tc_log(TC_LOG_ERROR, "tc_log: failed to start writer thread");
+        return false;
+    }
+    if (!g_async.atexit_registered) {
+        atexit(stop_at_exit);
+        g_async.atexit_registered = true;
+    }
+    g_async.enabled.store(true, std::memory_order_release);
+    return true;
+}
+
+void tc_log_stop_async(void) {
+    std::lock_guard<std::mutex> lock(g_async.control_mutex);
+    if (!g_async.enabled.load()) return;
+
+    // New messages go synchronous; wait for callers already in the ring path
+    g_async.enabled.store(false, std::memory_order_seq_cst);
+    while (g_async.producers.load(std::memory_order_acquire) != 0) {
+        std::this_thread::yield();
+    }
+
+    g_async.stop.store(true, std::memory_order_release);
+    wake_writer();
+    g_async.writer.join();
+
+    // Binary records logged after the writer's last pass
+    tc_log_binary_drain();
+}
+
+void tc_log_flush(void) {
+    g_async.producers.fetch_add(1, std::memory_order_acq_rel);
+    if (g_async.enabled.load(std::memory_order_acquire) && !t_is_writer) {
+        // Records may wait for messages in the ring, and draining them
+        // here queues them behind those messages
+        wait_written();
+        tc_log_binary_drain();
+        wait_written();
+    } else {
+        tc_log_binary_drain();
+    }
+    g_async.producers.fetch_sub(1, std::memory_order_release);
+    tc_log_sinks_flush();
+}
+
+uint64_t tc_log_dropped(void) {
+    return g_async.dropped.load(std::memory_order_relaxed);
+}
+
+// ============================================================================
+// Logging
+// ============================================================================
+
+void tc_log(tc_log_level level, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    log_v(level, format, args);
+    va_end(args);
+}
+
+void tc_log_debug(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    log_v(TC_LOG_DEBUG, format, args);
+    va_end(args);
+}
+
+void tc_log_info(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    log_v(TC_LOG_INFO, format, args);
+    va_end(args);
+}
+
+void tc_log_warn(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    log_v(TC_LOG_WARN, format, args);
+    va_end(args);
+}
+
+void tc_log_error(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    log_v(TC_LOG_ERROR, format, args);
+    va_end(args);
+}
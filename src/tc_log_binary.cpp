@@ -0,0 +1,444 @@
+// tc_log_binary.cpp - Deferred binary logging: per-thread record buffers and decoder
+#include <tcbase/tc_log_binary.h>
+#include "tc_log_internal.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+// ============================================================================
+// Internal structures
+// ============================================================================
+
+namespace {
+
+// [header][encoded args], 8-byte aligned. A record never wraps: if it does
+// not fit before the end, a padding header (or, when not even a header
+// fits, the bare tail) is skipped first.
+struct BinRecord {
+    uint32_t size;                 // Whole record
+    uint32_t level;                // PAD_LEVEL for padding
+    uint32_t arg_count;
+    uint32_t thread;
+    const char* format;
+    const uint8_t* arg_types;
+    uint64_t timestamp;
+    uint64_t after_ring;           // Held back until the async ring is written this far
+};
+
+constexpr uint32_t PAD_LEVEL = 0xFFFFFFFFu;
+constexpr size_t BUFFER_SIZE = 64 * 1024;
+constexpr size_t MESSAGE_MAX = 4096;
+
+inline size_t align8(size_t n) {
+    return (n + 7) & ~size_t(7);
+}
+
+// Single producer (the owning thread), single consumer (holder of the drain lock)
+struct ThreadBuffer {
+    char data[BUFFER_SIZE];
+    std::atomic<uint64_t> head{0};     // Published by the producer
+    std::atomic<uint64_t> tail{0};     // Released by the consumer
+    std::atomic<bool> abandoned{false};
+    uint64_t pending_end = 0;          // Producer only: head after the open record
+    uint32_t thread = 0;
+};
+
+struct Registry {
+    std::mutex mutex;                  // Guards buffers and next_thread
+    std::vector<ThreadBuffer*> buffers;
+    uint32_t next_thread = 1;
+    std::mutex drain_mutex;            // The single consumer
+};
+
+// Never destroyed: the async writer and atexit hooks may drain after
+// static destructors have run
+Registry& registry() {
+    static Registry* r = new Registry;
+    return *r;
+}
+
+struct BufferOwner {
+    ThreadBuffer* buffer = nullptr;
+
+    ~BufferOwner() {
+        // The drainer frees it once empty
+        if (buffer) buffer->abandoned.store(true, std::memory_order_release);
+    }
+};
+
+thread_local BufferOwner t_owner;
+thread_local bool t_in_drain = false;
+
+void drain_at_exit() {
+    tc_log_binary_drain();
+}
+
+ThreadBuffer* local_buffer() {
+    if (t_owner.buffer) return t_owner.buffer;
+
+    ThreadBuffer* buffer = new (std::nothrow) ThreadBuffer;
+    if (!buffer) return nullptr;
+
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    if (r.next_thread == 1) {
+        atexit(drain_at_exit);
+    }
+    buffer->thread = r.next_thread++;
+    r.buffers.push_back(buffer);
+    t_owner.buffer = buffer;
+    return buffer;
+}
+
+// Bytes to skip at pos before a record of need bytes (0 if it fits)
+inline size_t gap_before(uint64_t pos, size_t need) {
+    size_t to_end = BUFFER_SIZE - size_t(pos % BUFFER_SIZE);
+    return to_end < need ? to_end : 0;
+}
+
+BinRecord* record_at(ThreadBuffer* b, uint64_t pos) {
+    return reinterpret_cast<BinRecord*>(b->data + pos % BUFFER_SIZE);
+}
+
+// Producer: reserve need bytes; returns the record position or UINT64_MAX
+uint64_t buffer_reserve(ThreadBuffer* b, size_t need) {
+    uint64_t h = b->head.load(std::memory_order_relaxed);
+    size_t gap = gap_before(h, need);
+    if (h + gap + need - b->tail.load(std::memory_order_acquire) > BUFFER_SIZE) {
+        return UINT64_MAX;
+    }
+    if (gap >= sizeof(BinRecord)) {
+        BinRecord* pad = record_at(b, h);
+        pad->size = uint32_t(gap);
+        pad->level = PAD_LEVEL;
+    }
+    b->pending_end = h + gap + need;
+    return h + gap;
+}
+
+// ============================================================================
+// Decoding
+// ============================================================================
+
+struct ArgReader {
+    const uint8_t* types;
+    uint32_t count;
+    uint32_t next = 0;
+    const char* cursor;
+
+    bool take(uint8_t* type, const char** cell) {
+        if (next >= count) return false;
+        *type = types[next++];
+        *cell = cursor;
+        if (*type == TC_LOG_ARG_STR) {
+            uint32_t len;
+            memcpy(&len, cursor, sizeof(len));
+            cursor += align8(sizeof(uint32_t) + len + 1);
+        } else {
+            cursor += TC_LOG_ARG_CELL;
+        }
+        return true;
+    }
+};
+
+template<typename T>
+T cell_value(const char* cell) {
+    T value;
+    memcpy(&value, cell, sizeof(T));
+    return value;
+}
+
+bool is_integer_type(uint8_t type) {
+    return type <= TC_LOG_ARG_ULLONG;
+}
+
+const char* length_modifier(uint8_t type) {
+    switch (type) {
+    case TC_LOG_ARG_LONG:
+    case TC_LOG_ARG_ULONG:
+        return "l";
+    case TC_LOG_ARG_LLONG:
+    case TC_LOG_ARG_ULLONG:
+        return "ll";
+    default:
+        return "";
+    }
+}
+
+struct TextOut {
+    char* data;
+    size_t cap;                    // Includes the NUL
+    size_t len = 0;
+
+    void put(const char* s, size_t n) {
+        size_t room = cap - 1 - len;
+        if (n > room) n = room;
+        memcpy(data + len, s, n);
+        len += n;
+        data[len] = '\0';
+    }
+
+    // snprintf one conversion straight into the remaining space
+    template<typename T>
+    void print(const char* spec, T value) {
+        int n = snprintf(data + len, cap - len, spec, value);
+        if (n > 0) len += size_t(n) < cap - len ? size_t(n) : cap - 1 - len;
+    }
+};
+
+// printf-compatible formatting of encoded arguments, one conversion at a
+// time. Length modifiers in the format are replaced by ones matching the
+// encoded type; a conversion that does not fit its argument prints "<?>".
+size_t format_record(const char* format, ArgReader& args, char* out, size_t cap) {
+    TextOut text{out, cap};
+    out[0] = '\0';
+    const char* f = format;
+
+    while (*f) {
+        if (*f != '%') {
+            const char* run = f;
+            while (*f && *f != '%') f++;
+            text.put(run, size_t(f - run));
+            continue;
+        }
+        if (f[1] == '%') {
+            text.put("%", 1);
+            f += 2;
+            continue;
+        }
+
+        char spec[48];
+        size_t sl = 0;
+        spec[sl++] = *f++;
+        while (*f && strchr("-+ #0", *f) && sl < 8) spec[sl++] = *f++;
+
+        // Width and precision, with '*' taken from the arguments
+        for (int part = 0; part < 2; part++) {
+            if (part == 1) {
+                if (*f != '.') break;
+                spec[sl++] = *f++;
+            }
+            if (*f == '*') {
+                f++;
+                uint8_t type;
+                const char* cell;
+                int value = 0;
+                if (args.take(&type, &cell) && type == TC_LOG_ARG_INT) value = cell_value<int>(cell);
+                sl += size_t(snprintf(spec + sl, 12, "%d", value));
+            } else {
+                while (*f >= '0' && *f <= '9' && sl < 32) spec[sl++] = *f++;
+            }
+        }
+        while (*f && strchr("hljztL", *f)) f++;
+
+        char conv = *f;
+        if (!conv) break;
+        f++;
+
+        uint8_t type;
+        const char* cell;
+        if (!args.take(&type, &cell)) {
+            text.put("<?>", 3);
+            continue;
+        }
+        if (conv == 'n') continue;
+
+        const char* mod = length_modifier(type);
+        size_t ml = strlen(mod);
+        memcpy(spec + sl, mod, ml);
+        spec[sl + ml] = conv;
+        spec[sl + ml + 1] = '\0';
+
+        if (conv == 's' && type == TC_LOG_ARG_STR) {
+            text.print(spec, cell + sizeof(uint32_t));
+        } else if (conv == 'p' && type == TC_LOG_ARG_PTR) {
+            text.print(spec, cell_value<const void*>(cell));
+        } else if (strchr("fFeEgGaA", conv) && type == TC_LOG_ARG_DOUBLE) {
+            text.print(spec, cell_value<double>(cell));
+        } else if (strchr("diouxXc", conv) && is_integer_type(type)) {
+            switch (type) {
+            case TC_LOG_ARG_INT: text.print(spec, cell_value<int>(cell)); break;
+            case TC_LOG_ARG_UINT: text.print(spec, cell_value<unsigned int>(cell)); break;
+            case TC_LOG_ARG_LONG: text.print(spec, cell_value<long>(cell)); break;
+            case TC_LOG_ARG_ULONG: text.print(spec, cell_value<unsigned long>(cell)); break;
+            case TC_LOG_ARG_LLONG: text.print(spec, cell_value<long long>(cell)); break;
+            default: text.print(spec, cell_value<unsigned long long>(cell)); break;
+            }
+        } else {
+            text.put("<?>", 3);
+        }
+    }
+    return text.len;
+}
+
+void deliver_record(const BinRecord* rec) {
+    char text[MESSAGE_MAX];
+    ArgReader args{rec->arg_types, rec->arg_count, 0, reinterpret_cast<const char*>(rec + 1)};
+    size_t len = format_record(rec->format, args, text, sizeof(text));
+    tc_log_deliver(tc_log_level(rec->level), text, len);
+}
+
+// Consumer: position of the next real record before end, skipping padding
+bool next_record(ThreadBuffer* b, uint64_t end, uint64_t* pos) {
+    uint64_t t = b->tail.load(std::memory_order_relaxed);
+    while (t < end) {
+        size_t to_end = BUFFER_SIZE - size_t(t % BUFFER_SIZE);
+        if (to_end < sizeof(BinRecord)) {
+            t += to_end;
+            continue;
+        }
+        BinRecord* rec = record_at(b, t);
+        if (rec->level == PAD_LEVEL) {
+            t += rec->size;
+            continue;
+        }
+        break;
+    }
+    b->tail.store(t, std::memory_order_release);
+    *pos = t;
+    return t < end;
+}
+
+} // namespace
+
+// ============================================================================
+// Producer API
+// ============================================================================
+
+void* tc_log_binary_begin(
+    tc_log_level level,
+    const char* format,
+    const uint8_t* arg_types,
+    uint32_t arg_count,
+    size_t args_size
+) {
+    // A callback logging while records are drained goes synchronous
+    if (!format || t_in_drain || !tc::log_enabled(level)) return nullptr;
+
+    ThreadBuffer* b = local_buffer();
+    if (!b) return nullptr;
+
+    size_t need = align8(sizeof(BinRecord) + args_size);
+    if (need > BUFFER_SIZE / 2) return nullptr;
+
+    uint64_t pos = buffer_reserve(b, need);
+    if (pos == UINT64_MAX) {
+        tc_log_binary_drain();
+        pos = buffer_reserve(b, need);
+        if (pos == UINT64_MAX) return nullptr;
+    }
+
+    BinRecord* rec = record_at(b, pos);
+    rec->size = uint32_t(need);
+    rec->level = uint32_t(level);
+    rec->arg_count = arg_count;
+    rec->thread = b->thread;
+    rec->format = format;
+    rec->arg_types = arg_types;
+    rec->timestamp = uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+    rec->after_ring = tc_log_thread_ring_end();
+    return rec + 1;
+}
+
+void tc_log_binary_commit(void) {
+    ThreadBuffer* b = t_owner.buffer;
+    if (!b) return;
+    b->head.store(b->pending_end, std::memory_order_release);
+    tc_log_wake_writer();
+}
+
+void tc_log_binary_log_now(
+    tc_log_level level,
+    const char* format,
+    const uint8_t* arg_types,
+    uint32_t arg_count,
+    const void* args
+) {
+    if (!format || !tc::log_enabled(level)) return;
+
+    char text[MESSAGE_MAX];
+    ArgReader reader{arg_types, arg_count, 0, static_cast<const char*>(args)};
+    format_record(format, reader, text, sizeof(text));
+    tc_log(level, "%s", text);
+}
+
+// ============================================================================
+// Consumer
+// ============================================================================
+
+bool tc_log_binary_pending(void) {
+    // A drain delivers in order by itself
+    ThreadBuffer* b = t_owner.buffer;
+    return b && !t_in_drain && b->tail.load(std::memory_order_acquire) != b->head.load(std::memory_order_relaxed);
+}
+
+void tc_log_binary_drain(void) {
+    if (t_in_drain) return;
+
+    Registry& r = registry();
+    std::lock_guard<std::mutex> drain_lock(r.drain_mutex);
+    t_in_drain = true;
+
+    std::vector<ThreadBuffer*> buffers;
+    {
+        std::lock_guard<std::mutex> lock(r.mutex);
+        buffers = r.buffers;
+    }
+
+    // Drain what is published now, merging threads by timestamp. A thread
+    // stops at a record logged after a message still in the async ring.
+    uint64_t ring_written = tc_log_ring_written();
+    std::vector<uint64_t> ends(buffers.size());
+    for (size_t i = 0; i < buffers.size(); i++) {
+        ends[i] = buffers[i]->head.load(std::memory_order_acquire);
+    }
+
+    bool delivered = false;
+    for (;;) {
+        size_t best = SIZE_MAX;
+        uint64_t best_pos = 0;
+        uint64_t best_time = UINT64_MAX;
+        for (size_t i = 0; i < buffers.size(); i++) {
+            uint64_t pos;
+            if (!next_record(buffers[i], ends[i], &pos)) continue;
+            const BinRecord* rec = record_at(buffers[i], pos);
+            if (rec->after_ring > ring_written) continue;
+            uint64_t time = rec->timestamp;
+            if (time < best_time) {
+                best = i;
+                best_pos = pos;
+                best_time = time;
+            }
+        }
+        if (best == SIZE_MAX) break;
+
+        const BinRecord* rec = record_at(buffers[best], best_pos);
+        deliver_record(rec);
+        buffers[best]->tail.store(best_pos + rec->size, std::memory_order_release);
+        delivered = true;
+    }
+    if (delivered) tc_log_sinks_flush();
+
+    // Free buffers of exited threads once they are empty
+    {
+        std::lock_guard<std::mutex> lock(r.mutex);
+        for (size_t i = 0; i < r.buffers.size();) {
+            ThreadBuffer* b = r.buffers[i];
+            if (b->abandoned.load(std::memory_order_acquire) &&
+                b->tail.load(std::memory_order_relaxed) == b->head.load(std::memory_order_acquire)) {
+                r.buffers[i] = r.buffers.back();
+                r.buffers.pop_back();
+                delete b;
+            } else {
+                i++;
+            }
+        }
+    }
+    t_in_drain = false;
+}
@@ -0,0 +1,39 @@
+// tc_log_internal.h - Hooks shared by the tc_log backends
+#pragma once
+
+#include <tcbase/tc_log.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Deliver a formatted message: into the async ring, or straight to the
+// sinks when async mode is off or on the writer thread. Deferred records
+// the calling thread logged earlier are delivered first.
+// Never flushes, so it is safe while draining. Returns true if queued.
+bool tc_log_deliver(tc_log_level level, const char* message, size_t len);
+
+// Nudge the async writer, if running, to drain the binary buffers
+void tc_log_wake_writer(void);
+
+// Async ring position up to which messages have been written, and the end
+// of the calling thread's last message in the ring. A deferred record waits
+// for the plain messages its thread logged before it.
+uint64_t tc_log_ring_written(void);
+uint64_t tc_log_thread_ring_end(void);
+
+// True if the calling thread has deferred records not yet delivered
+bool tc_log_binary_pending(void);
+
+// Pass one message to every sink whose level it meets (tc_log_sinks.cpp)
+void tc_log_sinks_write(tc_log_level level, const char* message, size_t len);
+
+// End of a delivery batch: flush every sink
+void tc_log_sinks_flush(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,501 @@
+// tc_log_sinks.cpp - tc_log sink registry and built-in sinks
+#include <tcbase/tc_log_sink.h>
+#include "tc_log_internal.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <deque>
+#include <mutex>
+#include <new>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+// ============================================================================
+// Registry
+// ============================================================================
+
+namespace {
+
+const char* line_prefixes[] = {
+    "[DEBUG] ",
+    "[INFO] ",
+    "[WARN] ",
+    "[ERROR] "
+};
+
+struct Sink {
+    tc_log_sink_id id;
+    tc_log_sink_desc desc;
+};
+
+void stderr_write(void* user_data, tc_log_level level, const char* message, size_t len);
+void stderr_flush(void* user_data);
+
+// Recursive: a callback sink may log
+struct SinkRegistry {
+    std::recursive_mutex mutex;
+    std::vector<Sink> sinks;
+    tc_log_sink_id next_id = TC_LOG_STDERR_SINK + 1;
+    tc_log_sink_id callback_sink = TC_LOG_SINK_INVALID;   // tc_log_set_callback
+
+    SinkRegistry() {
+        tc_log_sink_desc desc = {};
+        desc.write = stderr_write;
+        desc.flush = stderr_flush;
+        desc.min_level = TC_LOG_DEBUG;
+        sinks.push_back({TC_LOG_STDERR_SINK, desc});
+    }
+};
+
+// Never destroyed: logging may run from atexit handlers
+SinkRegistry& registry() {
+    static SinkRegistry* r = new SinkRegistry;
+    return *r;
+}
+
+Sink* find_sink(SinkRegistry& r, tc_log_sink_id id) {
+    for (Sink& s : r.sinks) {
+        if (s.id == id) return &s;
+    }
+    return nullptr;
+}
+
+} // namespace
+
+void tc_log_sinks_write(tc_log_level level, const char* message, size_t len) {
+    SinkRegistry& r = registry();
+    std::lock_guard<std::recursive_mutex> lock(r.mutex);
+    // Index loop: a sink may log, and the vector may change meanwhile
+    for (size_t i = 0; i < r.sinks.size(); i++) {
+        tc_log_sink_desc desc = r.sinks[i].desc;
+        if (level >= desc.min_level) {
+            desc.write(desc.user_data, level, message, len);
+        }
+    }
+}
+
+void tc_log_sinks_flush(void) {
+    SinkRegistry& r = registry();
+    std::lock_guard<std::recursive_mutex> lock(r.mutex);
+    for (size_t i = 0; i < r.sinks.size(); i++) {
+        tc_log_sink_desc desc = r.sinks[i].desc;
+        if (desc.flush) desc.flush(desc.user_data);
+    }
+}
+
+tc_log_sink_id tc_log_add_sink(const tc_log_sink_desc* desc) {
+    if (!desc || !desc->write) return TC_LOG_SINK_INVALID;
+
+    SinkRegistry& r = registry();
+    std::lock_guard<std::recursive_mutex> lock(r.mutex);
+    tc_log_sink_id id = r.next_id++;
+    r.sinks.push_back({id, *desc});
+    return id;
+}
+
+bool tc_log_remove_sink(tc_log_sink_id id) {
+    SinkRegistry& r = registry();
+    std::lock_guard<std::recursive_mutex> lock(r.mutex);
+    for (size_t i = 0; i < r.sinks.size(); i++) {
+        if (r.sinks[i].id != id) continue;
+
+        tc_log_sink_desc desc = r.sinks[i].desc;
+        r.sinks.erase(r.sinks.begin() + ptrdiff_t(i));
+        if (id == r.callback_sink) r.callback_sink = TC_LOG_SINK_INVALID;
+        if (desc.flush) desc.flush(desc.user_data);
+        if (desc.destroy) desc.destroy(desc.user_data);
+        return true;
+    }
+    return false;
+}
+
+bool tc_log_sink_set_level(tc_log_sink_id id, tc_log_level min_level) {
+    SinkRegistry& r = registry();
+    std::lock_guard<std::recursive_mutex> lock(r.mutex);
+    Sink* sink = find_sink(r, id);
+    if (!sink) return false;
+    sink->desc.min_level = min_level;
+    return true;
+}
+
+// ============================================================================
+// Stderr sink
+// ============================================================================
+
+namespace {
+
+constexpr size_t STDERR_LINE_MAX = 4096 + 64;
+
+// stderr is unbuffered: assemble the line so it goes out in one write
+void stderr_write(void* user_data, tc_log_level level, const char* message, size_t len) {
+    (void)user_data;
+    const char* prefix = line_prefixes[level];
+    size_t prefix_len = strlen(prefix);
+
+    char line[STDERR_LINE_MAX];
+    if (prefix_len + len + 1 > sizeof(line)) {
+        fwrite(prefix, 1, prefix_len, stderr);
+        fwrite(message, 1, len, stderr);
+        fputc('\n', stderr);
+        return;
+    }
+    memcpy(line, prefix, prefix_len);
+    memcpy(line + prefix_len, message, len);
+    line[prefix_len + len] = '\n';
+    fwrite(line, 1, prefix_len + len + 1, stderr);
+}
+
+void stderr_flush(void* user_data) {
+    (void)user_data;
+    fflush(stderr);
+}
+
+} // namespace
+
+tc_log_sink_id tc_log_add_stderr_sink(tc_log_level min_level) {
+    tc_log_sink_desc desc = {};
+    desc.write = stderr_write;
+    desc.flush = stderr_flush;
+    desc.min_level = min_level;
+    return tc_log_add_sink(&desc);
+}
+
+// ============================================================================
+// Legacy callback
+// ============================================================================
+
+namespace {
+
+struct LegacyCallback {
+    tc_log_callback callback;
+};
+
+void legacy_write(void* user_data, tc_log_level level, const char* message, size_t len) {
+    (void)len;
+    static_cast<LegacyCallback*>(user_data)->callback(level, message);
+}
+
+void legacy_destroy(void* user_data) {
+    delete static_cast<LegacyCallback*>(user_data);
+}
+
+} // namespace
+
+void tc_log_set_callback(tc_log_callback callback) {
+    SinkRegistry& r = registry();
+    std::lock_guard<std::recursive_mutex> lock(r.mutex);
+
+    if (r.callback_sink != TC_LOG_SINK_INVALID) {
+        tc_log_remove_sink(r.callback_sink);
+    }
+    if (!callback) return;
+
+    LegacyCallback* holder = new (std::nothrow) LegacyCallback{callback};
+    if (!holder) return;
+
+    tc_log_sink_desc desc = {};
+    desc.write = legacy_write;
+    desc.destroy = legacy_destroy;
+    desc.user_data = holder;
+    desc.min_level = TC_LOG_DEBUG;
+
+    // Keep the callback ahead of stderr, as before sinks existed
+    tc_log_sink_id id = r.next_id++;
+    r.sinks.insert(r.sinks.begin(), {id, desc});
+    r.callback_sink = id;
+}
+
+// ============================================================================
+// Callback sink
+// ============================================================================
+
+tc_log_sink_id tc_log_add_callback_sink(tc_log_sink_write_fn fn, void* user_data, tc_log_level min_level) {
+    tc_log_sink_desc desc = {};
+    desc.write = fn;
+    desc.user_data = user_data;
+    desc.min_level = min_level;
+    return tc_log_add_sink(&desc);
+}
+
+// ============================================================================
+// File sink
+// ============================================================================
+
+namespace {
+
+constexpr size_t DEFAULT_FILE_BUFFER = 64 * 1024;
+
+struct FileSink {
+    std::string path;
+    tc_log_file_options options;
+#ifdef _WIN32
+    FILE* file = nullptr;
+#else
+    int fd = -1;
+#endif
+    std::vector<char> buffer;
+    size_t used = 0;
+    uint64_t size = 0;             // Current file size including buffered bytes
+    time_t opened = 0;
+    bool failed = false;           // Reported once, then lines are dropped
+};
+
+void file_report(FileSink* sink, const char* what) {
+    if (sink->failed) return;
+    sink->failed = true;
+    // Straight to stderr: logging here would come back into this sink
+    fprintf(stderr, "[ERROR] tc_log: %s '%s'\n", what, sink->path.c_str());
+    fflush(stderr);
+}
+
+bool file_open(FileSink* sink, bool append) {
+#ifdef _WIN32
+    sink->file = fopen(sink->path.c_str(), append ? "ab" : "wb");
+    if (!sink->file) return false;
+    _fseeki64(sink->file, 0, SEEK_END);
+    long long pos = _ftelli64(sink->file);
+    sink->size = pos > 0 ? uint64_t(pos) : 0;
+#else
+    int flags = O_WRONLY | O_CREAT | O_CLOEXEC | (append ? O_APPEND : O_TRUNC);
+    sink->fd = open(sink->path.c_str(), flags, 0644);
+    if (sink->fd < 0) return false;
+    off_t pos = lseek(sink->fd, 0, SEEK_END);
+    sink->size = pos > 0 ? uint64_t(pos) : 0;
+#endif
+    sink->opened = time(nullptr);
+    sink->failed = false;
+    return true;
+}
+
+void file_close(FileSink* sink) {
+#ifdef _WIN32
+    if (sink->file) fclose(sink->file);
+    sink->file = nullptr;
+#else
+    if (sink->fd >= 0) close(sink->fd);
+    sink->fd = -1;
+#endif
+}
+
+// Write all pieces in one call where the platform allows
+void file_write(FileSink* sink, const char* const* data, const size_t* lens, int count) {
+#ifdef _WIN32
+    if (!sink->file) return;
+    for (int i = 0; i < count; i++) {
+        if (fwrite(data[i], 1, lens[i], sink->file) != lens[i]) {
+            file_report(sink, "failed to write log file");
+            return;
+        }
+    }
+    fflush(sink->file);
+#else
+    if (sink->fd < 0) return;
+    struct iovec iov[4];
+    for (int i = 0; i < count; i++) {
+        iov[i].iov_base = const_cast<char*>(data[i]);
+        iov[i].iov_len = lens[i];
+    }
+    struct iovec* cur = iov;
+    int left = count;
+    while (left > 0) {
+        ssize_t n = writev(sink->fd, cur, left);
+        if (n < 0) {
+            file_report(sink, "failed to write log file");
+            return;
+        }
+        // Skip what was written; a partial write resumes mid-piece
+        while (left > 0 && size_t(n) >= cur->iov_len) {
+            n -= ssize_t(cur->iov_len);
+            cur++;
+            left--;
+        }
+        if (left > 0) {
+            cur->iov_base = static_cast<char*>(cur->iov_base) + n;
+            cur->iov_len -= size_t(n);
+        }
+    }
+#endif
+}
+
+void file_flush(void* user_data) {
+    FileSink* sink = static_cast<FileSink*>(user_data);
+    if (sink->used == 0) return;
+    const char* data[] = {sink->buffer.data()};
+    size_t lens[] = {sink->used};
+    file_write(sink, data, lens, 1);
+    sink->used = 0;
+}
+
+// Shift path.N-1 -> path.N ... path -> path.1 and start a new file
+void file_rotate(FileSink* sink) {
+    file_flush(sink);
+    file_close(sink);
+
+    uint32_t keep = sink->options.max_files;
+    if (keep == 0) {
+        remove(sink->path.c_str());
+    } else {
+        std::string dst = sink->path + "." + std::to_string(keep);
+        remove(dst.c_str());
+        for (uint32_t i = keep; i > 1; i--) {
+            std::string src = sink->path + "." + std::to_string(i - 1);
+            rename(src.c_str(), dst.c_str());
+            dst = src;
+        }
+        rename(sink->path.c_str(), dst.c_str());
+    }
+
+    if (!file_open(sink, false)) {
+        // Start a new period anyway: rotating again on every line would
+        // shift the kept files out one by one
+        sink->size = 0;
+        sink->opened = time(nullptr);
+        file_report(sink, "failed to reopen log file");
+    }
+}
+
+void file_sink_write(void* user_data, tc_log_level level, const char* message, size_t len) {
+    FileSink* sink = static_cast<FileSink*>(user_data);
+    const char* prefix = line_prefixes[level];
+    size_t prefix_len = strlen(prefix);
+    size_t line_len = prefix_len + len + 1;
+
+    const tc_log_file_options& o = sink->options;
+    bool too_big = o.max_bytes && sink->size > 0 && sink->size + line_len > o.max_bytes;
+    bool too_old = o.max_age_seconds && time(nullptr) - sink->opened >= time_t(o.max_age_seconds);
+    if (too_big || too_old) file_rotate(sink);
+
+    sink->size += line_len;
+    if (sink->used + line_len <= sink->buffer.size()) {
+        char* p = sink->buffer.data() + sink->used;
+        memcpy(p, prefix, prefix_len);
+        memcpy(p + prefix_len, message, len);
+        p[prefix_len + len] = '\n';
+        sink->used += line_len;
+        return;
+    }
+
+    // Buffer full: send it together with this line, without copying the line
+    const char* data[] = {sink->buffer.data(), prefix, message, "\n"};
+    size_t lens[] = {sink->used, prefix_len, len, 1};
+    file_write(sink, data, lens, 4);
+    sink->used = 0;
+}
+
+void file_sink_destroy(void* user_data) {
+    FileSink* sink = static_cast<FileSink*>(user_data);
+    file_flush(sink);
+    file_close(sink);
+    delete sink;
+}
+
+} // namespace
+
+tc_log_sink_id tc_log_add_file_sink(const char* path, const tc_log_file_options* options, tc_log_level min_level) {
+    if (!path) return TC_LOG_SINK_INVALID;
+
+    FileSink* sink = new (std::nothrow) FileSink;
+    if (!sink) return TC_LOG_SINK_INVALID;
+    sink->path = path;
+    sink->options = options ? *options : tc_log_file_options{};
+    sink->buffer.resize(sink->options.buffer_bytes ? sink->options.buffer_bytes : DEFAULT_FILE_BUFFER);
+
+    if (!file_open(sink, sink->options.append)) {
+        tc_log(TC_LOG_ERROR, "tc_log: cannot open log file '%s'", path);
+        delete sink;
+        return TC_LOG_SINK_INVALID;
+    }
+
+    tc_log_sink_desc desc = {};
+    desc.write = file_sink_write;
+    desc.flush = file_flush;
+    desc.destroy = file_sink_destroy;
+    desc.user_data = sink;
+    desc.min_level = min_level;
+    tc_log_sink_id id = tc_log_add_sink(&desc);
+    if (id == TC_LOG_SINK_INVALID) file_sink_destroy(sink);
+    return id;
+}
+
+// ============================================================================
+// Memory sink
+// ============================================================================
+
+namespace {
+
+struct MemorySink {
+    size_t capacity;
+    size_t bytes = 0;              // Sum of line lengths + one separator each
+    std::deque<std::string> lines;
+};
+
+void memory_write(void* user_data, tc_log_level level, const char* message, size_t len) {
+    MemorySink* sink = static_cast<MemorySink*>(user_data);
+    std::string line = line_prefixes[level];
+    line.append(message, len);
+    if (line.size() + 1 > sink->capacity) line.resize(sink->capacity ? sink->capacity - 1 : 0);
+
+    while (!sink->lines.empty() && sink->bytes + line.size() + 1 > sink->capacity) {
+        sink->bytes -= sink->lines.front().size() + 1;
+        sink->lines.pop_front();
+    }
+    sink->bytes += line.size() + 1;
+    sink->lines.push_back(std::move(line));
+}
+
+void memory_destroy(void* user_data) {
+    delete static_cast<MemorySink*>(user_data);
+}
+
+} // namespace
+
+tc_log_sink_id tc_log_add_memory_sink(size_t capacity, tc_log_level min_level) {
+    MemorySink* sink = new (std::nothrow) MemorySink;
+    if (!sink) return TC_LOG_SINK_INVALID;
+    sink->capacity = capacity;
+
+    tc_log_sink_desc desc = {};
+    desc.write = memory_write;
+    desc.destroy = memory_destroy;
+    desc.user_data = sink;
+    desc.min_level = min_level;
+    tc_log_sink_id id = tc_log_add_sink(&desc);
+    if (id == TC_LOG_SINK_INVALID) delete sink;
+    return id;
+}
+
+size_t tc_log_memory_sink_read(tc_log_sink_id id, char* out, size_t out_size) {
+    SinkRegistry& r = registry();
+    std::lock_guard<std::recursive_mutex> lock(r.mutex);
+    Sink* s = find_sink(r, id);
+    if (!s || s->desc.write != memory_write) {
+        if (out && out_size) out[0] = '\0';
+        return 0;
+    }
+
+    const MemorySink* sink = static_cast<const MemorySink*>(s->desc.user_data);
+    size_t total = 0;
+    for (const std::string& line : sink->lines) {
+        for (int part = 0; part < 2; part++) {
+            const char* data = part == 0 ? line.data() : "\n";
+            size_t n = part == 0 ? line.size() : 1;
+            if (out && total < out_size) {
+                size_t room = out_size - 1 - total;
+                memcpy(out + total, data, n < room ? n : room);
+            }
+            total += n;
+        }
+    }
+    if (out && out_size) out[total < out_size ? total : out_size - 1] = '\0';
+    return total;
+}
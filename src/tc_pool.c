@@ -1,98 +1,343 @@
 // tc_pool.c - Generic object pool implementation
 #include <tcbase/tc_pool.h>
 #include <tcbase/tc_log.h>
+#include "tc_file_map.h"
+#include "tc_pool_internal.h"
 #include <string.h>
 
 // ============================================================================
 // Internal helpers
 // ============================================================================
 
-static bool pool_grow(tc_pool* pool) {
-    uint32_t new_capacity = pool->capacity == 0 ? 16 : pool->capacity * 2;
+static inline bool pool_is_dense(const tc_pool* pool) {
+    return (pool->flags & TC_POOL_DENSE) != 0;
+}
 
-    // Reallocate data array
-    void* new_data = realloc(pool->data, new_capacity * pool->item_size);
-    if (!new_data) {
-        tc_log(TC_LOG_ERROR, "tc_pool: failed to grow data array");
+static inline bool pool_is_paged(const tc_pool* pool) {
+    return (pool->flags & TC_POOL_PAGED) != 0;
+}
+
+// Mapped pools are read-only views of an image
+static inline bool pool_check_mutable(const tc_pool* pool) {
+    if (pool->flags & TC_POOL_MAPPED) {
+        tc_log(TC_LOG_ERROR, "tc_pool: cannot modify a mapped pool");
         return false;
     }
+    return true;
+}
+
+static inline void pool_mark_occupied(tc_pool* pool, uint32_t index) {
+    pool->occupied[index / TC_POOL_WORD_BITS] |= (uint64_t)1 << (index % TC_POOL_WORD_BITS);
+}
+
+static inline void pool_mark_free(tc_pool* pool, uint32_t index) {
+    pool->occupied[index / TC_POOL_WORD_BITS] &= ~((uint64_t)1 << (index % TC_POOL_WORD_BITS));
+}
+
+// Move one item, through the relocate hook if set
+static inline void pool_relocate(tc_pool* pool, void* dst, void* src) {
+    if (pool->relocate_fn) {
+        pool->relocate_fn(dst, src, pool->hook_user_data);
+    } else {
+        memcpy(dst, src, pool->item_size);
+    }
+}
+
+// Relocate every live item of a flat/dense pool into new_data (same layout)
+static void pool_relocate_live(tc_pool* pool, void* new_data) {
+    if (pool_is_dense(pool)) {
+        for (uint32_t d = 0; d < pool->count; d++) {
+            size_t offset = (size_t)d * pool->item_stride;
+            pool_relocate(pool, (char*)new_data + offset, (char*)pool->data + offset);
+        }
+        return;
+    }
+    for (uint32_t w = 0; w < TC_POOL_WORD_COUNT(pool->capacity); w++) {
+        for (uint64_t bits = pool->occupied[w]; bits; bits &= bits - 1) {
+            size_t offset = (size_t)(w * TC_POOL_WORD_BITS + tc_pool_ctz64(bits)) * pool->item_stride;
+            pool_relocate(pool, (char*)new_data + offset, (char*)pool->data + offset);
+        }
+    }
+}
+
+static inline size_t pool_page_bytes(const tc_pool* pool) {
+    return ((size_t)1 << pool->page_shift) * pool->item_stride;
+}
+
+// Flat/dense mode: move the data block to new_capacity items. Aligned,
+// huge-page and relocate-hooked blocks cannot use realloc; they move into
+// a fresh block instead.
+static bool pool_resize_data(tc_pool* pool, uint32_t new_capacity) {
+    size_t new_bytes = (size_t)new_capacity * pool->item_stride;
+
+    if (!pool->relocate_fn && tc_pool_block_reallocable(pool)) {
+        void* p = realloc(pool->data, new_bytes);
+        if (!p) return false;
+        pool->data = p;
+        pool->data_bytes = new_bytes;
+        return true;
+    }
+
+    void* new_data = tc_pool_block_alloc(pool, new_bytes);
+    if (!new_data) return false;
+    if (pool->data) {
+        if (pool->relocate_fn) {
+            pool_relocate_live(pool, new_data);
+        } else {
+            memcpy(new_data, pool->data, new_bytes < pool->data_bytes ? new_bytes : pool->data_bytes);
+        }
+        tc_pool_block_free(pool, pool->data, pool->data_bytes);
+    }
     pool->data = new_data;
+    pool->data_bytes = new_bytes;
+    return true;
+}
 
-    // Zero-init new slots
-    memset((char*)pool->data + pool->capacity * pool->item_size,
-           0,
-           (new_capacity - pool->capacity) * pool->item_size);
+// Make room for n entries in every per-slot array (does not touch capacity)
+static bool pool_reserve_meta(tc_pool* pool, uint32_t n) {
+    if (n <= pool->meta_capacity) return true;
 
     // Reallocate generations
-    uint32_t* new_gens = (uint32_t*)realloc(pool->generations, new_capacity * sizeof(uint32_t));
+    uint32_t* new_gens = (uint32_t*)realloc(pool->generations, n * sizeof(uint32_t));
     if (!new_gens) {
         tc_log(TC_LOG_ERROR, "tc_pool: failed to grow generations array");
         return false;
     }
     pool->generations = new_gens;
 
-    // Init new generations to 1
-    for (uint32_t i = pool->capacity; i < new_capacity; i++) {
-        pool->generations[i] = 1;
-    }
-
-    // Reallocate states
-    uint8_t* new_states = (uint8_t*)realloc(pool->states, new_capacity * sizeof(uint8_t));
-    if (!new_states) {
-        tc_log(TC_LOG_ERROR, "tc_pool: failed to grow states array");
+    // Reallocate occupancy bitmap, new words start clear
+    uint32_t old_words = TC_POOL_WORD_COUNT(pool->meta_capacity);
+    uint32_t new_words = TC_POOL_WORD_COUNT(n);
+    uint64_t* new_occupied = (uint64_t*)realloc(pool->occupied, new_words * sizeof(uint64_t));
+    if (!new_occupied) {
+        tc_log(TC_LOG_ERROR, "tc_pool: failed to grow occupancy bitmap");
         return false;
     }
-    pool->states = new_states;
-
-    // Init new states to free
-    memset(pool->states + pool->capacity, TC_SLOT_FREE, new_capacity - pool->capacity);
+    pool->occupied = new_occupied;
+    memset(pool->occupied + old_words, 0, (new_words - old_words) * sizeof(uint64_t));
 
     // Reallocate free list
-    uint32_t* new_free = (uint32_t*)realloc(pool->free_list, new_capacity * sizeof(uint32_t));
+    uint32_t* new_free = (uint32_t*)realloc(pool->free_list, n * sizeof(uint32_t));
     if (!new_free) {
         tc_log(TC_LOG_ERROR, "tc_pool: failed to grow free list");
         return false;
     }
     pool->free_list = new_free;
 
-    // Add new slots to free list
+    // Reallocate dense mapping
+    if (pool_is_dense(pool)) {
+        uint32_t* new_s2d = (uint32_t*)realloc(pool->slot_to_dense, n * sizeof(uint32_t));
+        if (!new_s2d) {
+            tc_log(TC_LOG_ERROR, "tc_pool: failed to grow dense mapping");
+            return false;
+        }
+        pool->slot_to_dense = new_s2d;
+
+        uint32_t* new_d2s = (uint32_t*)realloc(pool->dense_to_slot, n * sizeof(uint32_t));
+        if (!new_d2s) {
+            tc_log(TC_LOG_ERROR, "tc_pool: failed to grow dense mapping");
+            return false;
+        }
+        pool->dense_to_slot = new_d2s;
+    }
+
+    pool->meta_capacity = n;
+    return true;
+}
+
+// Initialize slots [capacity, new_capacity) as free and extend capacity
+static void pool_init_slots(tc_pool* pool, uint32_t new_capacity) {
     for (uint32_t i = pool->capacity; i < new_capacity; i++) {
-        pool->free_list[pool->free_count++] = i;
+        pool->generations[i] = pool->generation_base;
+    }
+
+    // Occupancy bits past capacity are already clear
+
+    if (pool->slot_to_dense) {
+        for (uint32_t i = pool->capacity; i < new_capacity; i++) {
+            pool->slot_to_dense[i] = TC_POOL_NO_DENSE;
+        }
+    }
+
+    // Add new slots to free list (highest index first, so low slots are used first)
+    for (uint32_t i = new_capacity; i > pool->capacity; i--) {
+        pool->free_list[pool->free_count++] = i - 1;
     }
 
     pool->capacity = new_capacity;
+}
+
+// Flat/dense mode: grow the contiguous data array to new_capacity
+static bool pool_reserve(tc_pool* pool, uint32_t new_capacity) {
+    if (new_capacity <= pool->capacity) return true;
+
+    if (!pool_resize_data(pool, new_capacity)) {
+        tc_log(TC_LOG_ERROR, "tc_pool: failed to grow data array");
+        return false;
+    }
+
+    // Zero-init new slots
+    if (!(pool->flags & TC_POOL_NO_ZERO)) {
+        memset((char*)pool->data + (size_t)pool->capacity * pool->item_stride,
+               0,
+               (size_t)(new_capacity - pool->capacity) * pool->item_stride);
+    }
+
+    if (!pool_reserve_meta(pool, new_capacity)) return false;
+
+    pool_init_slots(pool, new_capacity);
+    return true;
+}
+
+// Paged mode: append one page to the page table. Existing items never move.
+static bool pool_add_page(tc_pool* pool) {
+    uint32_t page_items = 1u << pool->page_shift;
+    if (pool->capacity > UINT32_MAX - page_items) {
+        tc_log(TC_LOG_ERROR, "tc_pool: capacity limit reached");
+        return false;
+    }
+    uint32_t new_capacity = pool->capacity + page_items;
+
+    // Per-slot arrays grow geometrically, pages are added one at a time
+    uint32_t meta_target = pool->meta_capacity * 2;
+    if (meta_target < new_capacity) meta_target = new_capacity;
+    if (!pool_reserve_meta(pool, meta_target)) return false;
+
+    void** new_pages = (void**)realloc(pool->pages, (pool->page_count + 1) * sizeof(void*));
+    if (!new_pages) {
+        tc_log(TC_LOG_ERROR, "tc_pool: failed to grow page table");
+        return false;
+    }
+    pool->pages = new_pages;
+
+    uint32_t* new_live = (uint32_t*)realloc(pool->page_live, (pool->page_count + 1) * sizeof(uint32_t));
+    if (!new_live) {
+        tc_log(TC_LOG_ERROR, "tc_pool: failed to grow page table");
+        return false;
+    }
+    pool->page_live = new_live;
+
+    // Page memory is attached lazily by the first alloc in it
+    pool->pages[pool->page_count] = NULL;
+    pool->page_live[pool->page_count] = 0;
+    pool->page_count++;
+
+    pool_init_slots(pool, new_capacity);
     return true;
 }
 
+static bool pool_grow(tc_pool* pool) {
+    if (pool_is_paged(pool)) {
+        return pool_add_page(pool);
+    }
+    uint32_t new_capacity = pool->capacity == 0 ? 16 : pool->capacity * 2;
+    return pool_reserve(pool, new_capacity);
+}
+
+// Paged mode: make sure the page holding index has memory, count the slot as live
+static bool pool_page_acquire(tc_pool* pool, uint32_t index) {
+    uint32_t page = index >> pool->page_shift;
+    if (!pool->pages[page]) {
+        void* mem = pool->spare_page;
+        pool->spare_page = NULL;
+        if (!mem) {
+            mem = tc_pool_block_alloc(pool, pool_page_bytes(pool));
+            if (!mem) {
+                tc_log(TC_LOG_ERROR, "tc_pool: failed to allocate page");
+                return false;
+            }
+        }
+        pool->pages[page] = mem;
+    }
+    pool->page_live[page]++;
+    return true;
+}
+
+// Paged mode: drop a live slot; an emptied page goes to the spare slot or the OS
+static void pool_page_release(tc_pool* pool, uint32_t index) {
+    uint32_t page = index >> pool->page_shift;
+    if (--pool->page_live[page] > 0) return;
+
+    if (!pool->spare_page) {
+        pool->spare_page = pool->pages[page];
+    } else {
+        tc_pool_block_free(pool, pool->pages[page], pool_page_bytes(pool));
+    }
+    pool->pages[page] = NULL;
+}
+
 // ============================================================================
 // Lifecycle
 // ============================================================================
 
 bool tc_pool_init(tc_pool* pool, size_t item_size, uint32_t initial_capacity) {
-    if (!pool || item_size == 0) return false;
+    tc_pool_desc desc;
+    memset(&desc, 0, sizeof(desc));
+    desc.item_size = item_size;
+    desc.initial_capacity = initial_capacity;
+    return tc_pool_init_ex(pool, &desc);
+}
 
-    memset(pool, 0, sizeof(tc_pool));
-    pool->item_size = item_size;
+bool tc_pool_init_ex(tc_pool* pool, const tc_pool_desc* desc) {
+    if (!pool || !desc || desc->item_size == 0) return false;
 
-    if (initial_capacity > 0) {
-        pool->data = calloc(initial_capacity, item_size);
-        pool->generations = (uint32_t*)malloc(initial_capacity * sizeof(uint32_t));
-        pool->states = (uint8_t*)calloc(initial_capacity, sizeof(uint8_t));
-        pool->free_list = (uint32_t*)malloc(initial_capacity * sizeof(uint32_t));
+    size_t alignment = desc->alignment;
+    if (alignment & (alignment - 1) || alignment > TC_POOL_MAX_ALIGNMENT) {
+        tc_log(TC_LOG_ERROR, "tc_pool: alignment must be a power of two up to %d", TC_POOL_MAX_ALIGNMENT);
+        return false;
+    }
+    size_t stride = desc->stride;
+    if (stride == 0) {
+        size_t unit = alignment ? alignment : 1;
+        stride = (desc->item_size + unit - 1) / unit * unit;
+    }
+    if (stride < desc->item_size || (alignment && stride % alignment != 0)) {
+        tc_log(TC_LOG_ERROR, "tc_pool: stride must cover item_size and be a multiple of alignment");
+        return false;
+    }
 
-        if (!pool->data || !pool->generations || !pool->states || !pool->free_list) {
-            tc_pool_free(pool);
-            return false;
+    if ((desc->flags & TC_POOL_DENSE) && (desc->flags & TC_POOL_PAGED)) {
+        tc_log(TC_LOG_ERROR, "tc_pool: TC_POOL_DENSE and TC_POOL_PAGED are mutually exclusive");
+        return false;
+    }
+
+    memset(pool, 0, sizeof(tc_pool));
+    pool->item_size = desc->item_size;
+    pool->item_stride = stride;
+    pool->alignment = alignment;
+    pool->flags = desc->flags;
+    pool->generation_base = 1;
+    pool->init_fn = desc->init;
+    pool->destroy_fn = desc->destroy;
+    pool->relocate_fn = desc->relocate;
+    pool->init_batch_fn = desc->init_batch;
+    pool->hook_user_data = desc->hook_user_data;
+
+    if (pool_is_paged(pool)) {
+        uint32_t page_items = desc->page_items;
+        if (page_items == 0) {
+            size_t page_bytes = (pool->flags & TC_POOL_HUGE_PAGES)
+                ? TC_POOL_HUGE_PAGE_BYTES
+                : TC_POOL_DEFAULT_PAGE_BYTES;
+            size_t fit = page_bytes / stride;
+            page_items = fit > 0 ? (uint32_t)fit : 1;
+        }
+        while (pool->page_shift < 24 && (1u << pool->page_shift) < page_items) {
+            pool->page_shift++;
         }
 
-        // Init generations to 1
-        for (uint32_t i = 0; i < initial_capacity; i++) {
-            pool->generations[i] = 1;
-            pool->free_list[i] = i;
+        while (pool->capacity < desc->initial_capacity) {
+            if (!pool_add_page(pool)) {
+                tc_pool_free(pool);
+                return false;
+            }
         }
+        return true;
+    }
 
-        pool->capacity = initial_capacity;
-        pool->free_count = initial_capacity;
+    if (desc->initial_capacity > 0 && !pool_reserve(pool, desc->initial_capacity)) {
+        tc_pool_free(pool);
+        return false;
     }
 
     return true;
@@ -101,55 +346,259 @@ bool tc_pool_init(tc_pool* pool, size_t item_size, uint32_t initial_capacity) {
 void tc_pool_free(tc_pool* pool) {
     if (!pool) return;
 
-    free(pool->data);
+    if (pool->flags & TC_POOL_MAPPED) {
+        tc_file_unmap(pool->mapping, pool->mapping_size);
+        memset(pool, 0, sizeof(tc_pool));
+        return;
+    }
+
+    // Destroy items still alive
+    if (pool->destroy_fn) {
+        for (uint32_t w = 0; w < TC_POOL_WORD_COUNT(pool->capacity); w++) {
+            for (uint64_t bits = pool->occupied[w]; bits; bits &= bits - 1) {
+                uint32_t i = w * TC_POOL_WORD_BITS + tc_pool_ctz64(bits);
+                pool->destroy_fn(tc_pool_get_unchecked(pool, i), pool->hook_user_data);
+            }
+        }
+    }
+
+    size_t page_bytes = pool_page_bytes(pool);
+    tc_pool_block_free(pool, pool->data, pool->data_bytes);
     free(pool->generations);
-    free(pool->states);
+    free(pool->occupied);
     free(pool->free_list);
+    free(pool->slot_to_dense);
+    free(pool->dense_to_slot);
+
+    for (uint32_t p = 0; p < pool->page_count; p++) {
+        tc_pool_block_free(pool, pool->pages[p], page_bytes);
+    }
+    free(pool->pages);
+    free(pool->page_live);
+    tc_pool_block_free(pool, pool->spare_page, page_bytes);
 
     memset(pool, 0, sizeof(tc_pool));
 }
 
 void tc_pool_clear(tc_pool* pool) {
-    if (!pool) return;
-
-    // Bump all generations and mark as free
-    for (uint32_t i = 0; i < pool->capacity; i++) {
-        if (pool->states[i] == TC_SLOT_OCCUPIED) {
+    if (!pool || !pool_check_mutable(pool)) return;
+
+    // Bump generations of occupied slots and mark all as free,
+    // skipping empty bitmap words
+    uint32_t words = TC_POOL_WORD_COUNT(pool->capacity);
+    for (uint32_t w = 0; w < words; w++) {
+        uint64_t bits = pool->occupied[w];
+        if (!bits) continue;
+        pool->occupied[w] = 0;
+        for (; bits; bits &= bits - 1) {
+            uint32_t i = w * TC_POOL_WORD_BITS + tc_pool_ctz64(bits);
+            if (pool->destroy_fn) {
+                pool->destroy_fn(tc_pool_get_unchecked(pool, i), pool->hook_user_data);
+            }
             pool->generations[i]++;
-            pool->states[i] = TC_SLOT_FREE;
+            if (pool->slot_to_dense) pool->slot_to_dense[i] = TC_POOL_NO_DENSE;
         }
     }
 
     // Rebuild free list
     pool->free_count = 0;
-    for (uint32_t i = 0; i < pool->capacity; i++) {
-        pool->free_list[pool->free_count++] = i;
+    for (uint32_t i = pool->capacity; i > 0; i--) {
+        pool->free_list[pool->free_count++] = i - 1;
+    }
+
+    // Pages stay attached; tc_pool_trim returns them to the OS
+    for (uint32_t p = 0; p < pool->page_count; p++) {
+        pool->page_live[p] = 0;
     }
 
     pool->count = 0;
 }
 
+void tc_pool_trim(tc_pool* pool) {
+    if (!pool || !pool_is_paged(pool) || !pool_check_mutable(pool)) return;
+
+    for (uint32_t p = 0; p < pool->page_count; p++) {
+        if (pool->pages[p] && pool->page_live[p] == 0) {
+            tc_pool_block_free(pool, pool->pages[p], pool_page_bytes(pool));
+            pool->pages[p] = NULL;
+        }
+    }
+
+    tc_pool_block_free(pool, pool->spare_page, pool_page_bytes(pool));
+    pool->spare_page = NULL;
+}
+
 // ============================================================================
-// Operations
+// Compaction
 // ============================================================================
 
-tc_handle tc_pool_alloc(tc_pool* pool) {
-    if (!pool) return TC_HANDLE_INVALID;
+// Shrink every per-slot array to n entries (n == 0 frees them)
+static void pool_shrink_meta(tc_pool* pool, uint32_t n) {
+    if (n == 0) {
+        free(pool->generations);
+        free(pool->occupied);
+        free(pool->free_list);
+        free(pool->slot_to_dense);
+        free(pool->dense_to_slot);
+        pool->generations = NULL;
+        pool->occupied = NULL;
+        pool->free_list = NULL;
+        pool->slot_to_dense = NULL;
+        pool->dense_to_slot = NULL;
+        pool->meta_capacity = 0;
+        return;
+    }
 
-    // Grow if no free slots
-    if (pool->free_count == 0) {
-        if (!pool_grow(pool)) {
-            return TC_HANDLE_INVALID;
+    // Shrinking realloc failures leave the larger block, which is still valid
+    void* p;
+    if ((p = realloc(pool->generations, n * sizeof(uint32_t)))) pool->generations = (uint32_t*)p;
+    if ((p = realloc(pool->occupied, TC_POOL_WORD_COUNT(n) * sizeof(uint64_t)))) pool->occupied = (uint64_t*)p;
+    if ((p = realloc(pool->free_list, n * sizeof(uint32_t)))) pool->free_list = (uint32_t*)p;
+    if (pool->slot_to_dense) {
+        if ((p = realloc(pool->slot_to_dense, n * sizeof(uint32_t)))) pool->slot_to_dense = (uint32_t*)p;
+        if ((p = realloc(pool->dense_to_slot, n * sizeof(uint32_t)))) pool->dense_to_slot = (uint32_t*)p;
+    }
+    pool->meta_capacity = n;
+}
+
+// Move the live item at slot src to the free slot dst
+static bool pool_move_slot(tc_pool* pool, uint32_t src, uint32_t dst) {
+    if (pool_is_dense(pool)) {
+        // Items are already packed; only the slot mapping changes
+        uint32_t d = pool->slot_to_dense[src];
+        pool->slot_to_dense[dst] = d;
+        pool->dense_to_slot[d] = dst;
+        pool->slot_to_dense[src] = TC_POOL_NO_DENSE;
+    } else {
+        if (pool_is_paged(pool) && !pool_page_acquire(pool, dst)) return false;
+        pool_relocate(pool, tc_pool_get_unchecked(pool, dst), tc_pool_get_unchecked(pool, src));
+        if (pool_is_paged(pool)) pool_page_release(pool, src);
+    }
+
+    // dst keeps its generation: it was bumped when dst was freed, so no
+    // handle with that generation was ever issued
+    pool_mark_occupied(pool, dst);
+    pool_mark_free(pool, src);
+    pool->generations[src]++;
+    return true;
+}
+
+bool tc_pool_compact(tc_pool* pool, tc_handle* out_remap) {
+    if (!pool || !pool_check_mutable(pool)) return false;
+
+    uint32_t old_capacity = pool->capacity;
+    if (out_remap) {
+        for (uint32_t i = 0; i < old_capacity; i++) {
+            if (tc_pool_slot_occupied(pool, i)) {
+                out_remap[i].index = i;
+                out_remap[i].generation = pool->generations[i];
+            } else {
+                out_remap[i] = TC_HANDLE_INVALID;
+            }
         }
     }
 
-    // Pop from free list
-    uint32_t index = pool->free_list[--pool->free_count];
-    pool->states[index] = TC_SLOT_OCCUPIED;
+    // Fill holes below count with items from the top
+    bool ok = true;
+    uint32_t dst = 0;
+    uint32_t src = old_capacity;
+    for (;;) {
+        while (dst < pool->count && tc_pool_slot_occupied(pool, dst)) dst++;
+        while (src > pool->count && !tc_pool_slot_occupied(pool, src - 1)) src--;
+        if (dst >= pool->count || src <= pool->count) break;
+
+        if (!pool_move_slot(pool, src - 1, dst)) {
+            tc_log(TC_LOG_ERROR, "tc_pool: compaction stopped, out of memory");
+            ok = false;
+            break;
+        }
+        if (out_remap) {
+            out_remap[src - 1].index = dst;
+            out_remap[src - 1].generation = pool->generations[dst];
+        }
+    }
+
+    uint32_t new_capacity = pool->count;
+    if (!ok) {
+        new_capacity = old_capacity;
+    } else if (pool_is_paged(pool)) {
+        uint32_t page_items = 1u << pool->page_shift;
+        new_capacity = (uint32_t)(((uint64_t)pool->count + page_items - 1) & ~(uint64_t)(page_items - 1));
+    }
+
+    // Slots past the new end disappear; regrown slots must start above any
+    // generation a stale handle could carry
+    for (uint32_t i = new_capacity; i < old_capacity; i++) {
+        if (pool->generations[i] > pool->generation_base) {
+            pool->generation_base = pool->generations[i];
+        }
+    }
+
+    if (new_capacity < old_capacity) {
+        if (pool_is_paged(pool)) {
+            uint32_t new_page_count = new_capacity >> pool->page_shift;
+            for (uint32_t p = new_page_count; p < pool->page_count; p++) {
+                tc_pool_block_free(pool, pool->pages[p], pool_page_bytes(pool));
+            }
+            pool->page_count = new_page_count;
+            if (new_page_count == 0) {
+                free(pool->pages);
+                free(pool->page_live);
+                pool->pages = NULL;
+                pool->page_live = NULL;
+            }
+        } else if (new_capacity == 0) {
+            tc_pool_block_free(pool, pool->data, pool->data_bytes);
+            pool->data = NULL;
+            pool->data_bytes = 0;
+        } else {
+            // A failed shrink leaves the larger block, which is still valid
+            pool_resize_data(pool, new_capacity);
+        }
+        pool_shrink_meta(pool, new_capacity);
+        pool->capacity = new_capacity;
+    }
+
+    // Rebuild free list (highest index first, so low slots are used first)
+    pool->free_count = 0;
+    for (uint32_t i = pool->capacity; i > 0; i--) {
+        if (!tc_pool_slot_occupied(pool, i - 1)) {
+            pool->free_list[pool->free_count++] = i - 1;
+        }
+    }
+
+    return ok;
+}
+
+// ============================================================================
+// Operations
+// ============================================================================
+
+// Pop a slot from the (non-empty) free list and mark it occupied.
+// run_init is false when the caller constructs the item itself.
+static tc_handle pool_take_slot(tc_pool* pool, bool run_init) {
+    uint32_t index = pool->free_list[pool->free_count - 1];
+    if (pool_is_paged(pool) && !pool_page_acquire(pool, index)) {
+        return TC_HANDLE_INVALID;
+    }
+    pool->free_count--;
+    pool_mark_occupied(pool, index);
+
+    // Dense mode: append to the packed array
+    if (pool_is_dense(pool)) {
+        pool->slot_to_dense[index] = pool->count;
+        pool->dense_to_slot[pool->count] = index;
+    }
     pool->count++;
 
     // Zero-init the slot data
-    memset((char*)pool->data + index * pool->item_size, 0, pool->item_size);
+    void* item = tc_pool_get_unchecked(pool, index);
+    if (!(pool->flags & TC_POOL_NO_ZERO)) {
+        memset(item, 0, pool->item_size);
+    }
+    if (run_init && pool->init_fn) {
+        pool->init_fn(item, pool->hook_user_data);
+    }
 
     tc_handle h;
     h.index = index;
@@ -157,34 +606,179 @@ tc_handle tc_pool_alloc(tc_pool* pool) {
     return h;
 }
 
-bool tc_pool_free_slot(tc_pool* pool, tc_handle h) {
-    if (!pool) return false;
-    if (h.index >= pool->capacity) return false;
-    if (pool->states[h.index] != TC_SLOT_OCCUPIED) return false;
-    if (pool->generations[h.index] != h.generation) return false;
+// Release an occupied slot (index must be valid)
+static void pool_release_slot(tc_pool* pool, uint32_t index) {
+    if (pool->destroy_fn) {
+        pool->destroy_fn(tc_pool_get_unchecked(pool, index), pool->hook_user_data);
+    }
+
+    // Dense mode: move the last packed item into the hole
+    if (pool_is_dense(pool)) {
+        uint32_t hole = pool->slot_to_dense[index];
+        uint32_t last = pool->count - 1;
+        if (hole != last) {
+            uint32_t moved_slot = pool->dense_to_slot[last];
+            pool_relocate(pool,
+                          (char*)pool->data + (size_t)hole * pool->item_stride,
+                          (char*)pool->data + (size_t)last * pool->item_stride);
+            pool->dense_to_slot[hole] = moved_slot;
+            pool->slot_to_dense[moved_slot] = hole;
+        }
+        pool->slot_to_dense[index] = TC_POOL_NO_DENSE;
+    }
 
     // Mark as free
-    pool->states[h.index] = TC_SLOT_FREE;
-    pool->generations[h.index]++;  // Bump generation
+    pool_mark_free(pool, index);
+    pool->generations[index]++;  // Bump generation
     pool->count--;
 
+    if (pool_is_paged(pool)) {
+        pool_page_release(pool, index);
+    }
+
     // Add to free list
-    pool->free_list[pool->free_count++] = h.index;
+    pool->free_list[pool->free_count++] = index;
+}
+
+static inline bool pool_is_valid(const tc_pool* pool, tc_handle h) {
+    if (h.index >= pool->capacity) return false;
+    if (!tc_pool_slot_occupied(pool, h.index)) return false;
+    if (pool->generations[h.index] != h.generation) return false;
+    return true;
+}
+
+// Validity bits for up to 64 handles. Branch-free so the loop vectorizes:
+// out-of-range indices are clamped to slot 0 and masked out afterwards.
+static inline uint64_t pool_validate_block(const tc_pool* pool, const tc_handle* handles, uint32_t n) {
+    const uint32_t* generations = pool->generations;
+    const uint64_t* occupied = pool->occupied;
+    uint32_t capacity = pool->capacity;
+    uint64_t bits = 0;
+    if (capacity == 0) return 0;
+
+    for (uint32_t i = 0; i < n; i++) {
+        uint32_t index = handles[i].index;
+        uint32_t in_range = index < capacity;
+        uint32_t safe = in_range ? index : 0;
+        uint64_t ok = in_range
+                    & (uint32_t)((occupied[safe / TC_POOL_WORD_BITS] >> (safe % TC_POOL_WORD_BITS)) & 1)
+                    & (uint32_t)(generations[safe] == handles[i].generation);
+        bits |= ok << i;
+    }
+    return bits;
+}
+
+tc_handle tc_pool_alloc(tc_pool* pool) {
+    if (!pool || !pool_check_mutable(pool)) return TC_HANDLE_INVALID;
+
+    // Grow if no free slots
+    if (pool->free_count == 0) {
+        if (!pool_grow(pool)) {
+            return TC_HANDLE_INVALID;
+        }
+    }
+
+    return pool_take_slot(pool, true);
+}
 
+bool tc_pool_free_slot(tc_pool* pool, tc_handle h) {
+    if (!pool || !pool_check_mutable(pool) || !pool_is_valid(pool, h)) return false;
+    pool_release_slot(pool, h.index);
     return true;
 }
 
 bool tc_pool_is_valid(const tc_pool* pool, tc_handle h) {
     if (!pool) return false;
-    if (h.index >= pool->capacity) return false;
-    if (pool->states[h.index] != TC_SLOT_OCCUPIED) return false;
-    if (pool->generations[h.index] != h.generation) return false;
-    return true;
+    return pool_is_valid(pool, h);
 }
 
 void* tc_pool_get(const tc_pool* pool, tc_handle h) {
-    if (!tc_pool_is_valid(pool, h)) return NULL;
-    return (char*)pool->data + h.index * pool->item_size;
+    if (!pool || !pool_is_valid(pool, h)) return NULL;
+    return tc_pool_get_unchecked(pool, h.index);
+}
+
+// ============================================================================
+// Batch operations
+// ============================================================================
+
+uint32_t tc_pool_alloc_n(tc_pool* pool, uint32_t n, tc_handle* out_handles) {
+    if (!pool || !out_handles || !pool_check_mutable(pool)) return 0;
+
+    // Grow once up front instead of on every alloc
+    if (pool->free_count < n) {
+        if (pool_is_paged(pool)) {
+            while (pool->free_count < n && pool_add_page(pool)) {}
+        } else {
+            uint32_t needed = pool->capacity + (n - pool->free_count);
+            uint32_t doubled = pool->capacity == 0 ? 16 : pool->capacity * 2;
+            pool_reserve(pool, needed > doubled ? needed : doubled);
+        }
+    }
+
+    bool batch_init = pool->init_batch_fn != NULL;
+    uint32_t allocated = 0;
+    while (allocated < n && pool->free_count > 0) {
+        tc_handle h = pool_take_slot(pool, !batch_init);
+        if (tc_handle_is_invalid(h)) break;
+        out_handles[allocated++] = h;
+    }
+
+    if (batch_init && allocated > 0) {
+        pool->init_batch_fn(pool, out_handles, allocated, pool->hook_user_data);
+    }
+
+    for (uint32_t i = allocated; i < n; i++) {
+        out_handles[i] = TC_HANDLE_INVALID;
+    }
+    return allocated;
+}
+
+uint32_t tc_pool_free_n(tc_pool* pool, const tc_handle* handles, uint32_t n) {
+    if (!pool || !handles || !pool_check_mutable(pool)) return 0;
+
+    // Validate one at a time: a handle freed earlier in the batch
+    // makes its duplicates stale
+    uint32_t freed = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        if (pool_is_valid(pool, handles[i])) {
+            pool_release_slot(pool, handles[i].index);
+            freed++;
+        }
+    }
+    return freed;
+}
+
+uint32_t tc_pool_validate_many(const tc_pool* pool, const tc_handle* handles, uint32_t n, uint64_t* out_mask) {
+    if (!pool || !handles || !out_mask) return 0;
+
+    uint32_t valid = 0;
+    for (uint32_t base = 0; base < n; base += 64) {
+        uint32_t block = n - base < 64 ? n - base : 64;
+        uint64_t bits = pool_validate_block(pool, handles + base, block);
+        out_mask[base / 64] = bits;
+        for (uint64_t b = bits; b; b &= b - 1) valid++;
+    }
+    return valid;
+}
+
+uint32_t tc_pool_get_many(const tc_pool* pool, const tc_handle* handles, uint32_t n,
+                          void** out_items, uint64_t* out_mask) {
+    if (!pool || !handles || !out_items) return 0;
+
+    uint32_t valid = 0;
+    for (uint32_t base = 0; base < n; base += 64) {
+        uint32_t block = n - base < 64 ? n - base : 64;
+        uint64_t bits = pool_validate_block(pool, handles + base, block);
+        if (out_mask) out_mask[base / 64] = bits;
+
+        for (uint32_t i = 0; i < block; i++) {
+            out_items[base + i] = ((bits >> i) & 1)
+                ? tc_pool_get_unchecked(pool, handles[base + i].index)
+                : NULL;
+        }
+        for (uint64_t b = bits; b; b &= b - 1) valid++;
+    }
+    return valid;
 }
 
 // ============================================================================
@@ -194,12 +788,31 @@ void* tc_pool_get(const tc_pool* pool, tc_handle h) {
 void tc_pool_foreach(tc_pool* pool, tc_pool_iter_fn callback, void* user_data) {
     if (!pool || !callback) return;
 
-    for (uint32_t i = 0; i < pool->capacity; i++) {
-        if (pool->states[i] == TC_SLOT_OCCUPIED) {
-            void* item = (char*)pool->data + i * pool->item_size;
-            if (!callback(i, item, user_data)) {
+    // Dense mode: stream the packed array. Walking backwards keeps the
+    // iteration correct if the callback frees the current item.
+    if (pool_is_dense(pool)) {
+        for (uint32_t d = pool->count; d > 0; d--) {
+            if (d > pool->count) continue;
+            void* item = (char*)pool->data + (size_t)(d - 1) * pool->item_stride;
+            if (!callback(pool->dense_to_slot[d - 1], item, user_data)) {
                 break;
             }
         }
+        return;
+    }
+
+    // Scan the bitmap a word at a time; empty words (including released
+    // pages) are skipped whole. The word is reloaded after each callback so
+    // slots freed by the callback are not visited.
+    for (uint32_t w = 0; w < TC_POOL_WORD_COUNT(pool->capacity); w++) {
+        uint64_t bits = pool->occupied[w];
+        while (bits) {
+            uint32_t bit = tc_pool_ctz64(bits);
+            uint32_t i = w * TC_POOL_WORD_BITS + bit;
+            if (!callback(i, tc_pool_get_unchecked(pool, i), user_data)) {
+                return;
+            }
+            bits = pool->occupied[w] & (~(uint64_t)1 << bit);
+        }
     }
 }
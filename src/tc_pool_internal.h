@@ -0,0 +1,15 @@
+// tc_pool_internal.h - Helpers shared between tc_pool translation units
+#pragma once
+
+#include <tcbase/tc_pool.h>
+#include <stddef.h>
+
+// Allocate a data block or page honoring the pool's alignment and
+// TC_POOL_HUGE_PAGES. Contents are unspecified.
+void* tc_pool_block_alloc(const tc_pool* pool, size_t size);
+
+// Free a block from tc_pool_block_alloc; size must match the allocation
+void tc_pool_block_free(const tc_pool* pool, void* block, size_t size);
+
+// True if blocks are plain malloc memory that realloc may resize
+bool tc_pool_block_reallocable(const tc_pool* pool);
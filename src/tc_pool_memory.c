@@ -0,0 +1,103 @@
+// tc_pool_memory.c - Backing memory for tc_pool data blocks and pages
+#include <tcbase/tc_pool.h>
+#include "tc_pool_internal.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <malloc.h>
+#else
+#include <sys/mman.h>
+#endif
+
+// ============================================================================
+// Huge pages
+// ============================================================================
+
+static size_t round_up(size_t size, size_t granularity) {
+    return (size + granularity - 1) / granularity * granularity;
+}
+
+// Large pages when the OS grants them, regular pages otherwise.
+// Memory comes back zeroed.
+static void* huge_alloc(size_t size) {
+#ifdef _WIN32
+    SIZE_T large = GetLargePageMinimum();
+    if (large > 0) {
+        void* p = VirtualAlloc(NULL, round_up(size, large),
+                               MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+        if (p) return p;
+    }
+    return VirtualAlloc(NULL, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+    size_t rounded = round_up(size, TC_POOL_HUGE_PAGE_BYTES);
+    void* p = MAP_FAILED;
+#ifdef MAP_HUGETLB
+    p = mmap(NULL, rounded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#endif
+    if (p == MAP_FAILED) {
+        // No reserved hugetlb pages: ask for transparent huge pages instead
+        p = mmap(NULL, rounded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED) return NULL;
+#ifdef MADV_HUGEPAGE
+        madvise(p, rounded, MADV_HUGEPAGE);
+#endif
+    }
+    return p;
+#endif
+}
+
+static void huge_free(void* block, size_t size) {
+#ifdef _WIN32
+    (void)size;
+    VirtualFree(block, 0, MEM_RELEASE);
+#else
+    munmap(block, round_up(size, TC_POOL_HUGE_PAGE_BYTES));
+#endif
+}
+
+// ============================================================================
+// Block allocation
+// ============================================================================
+
+static inline bool needs_aligned_alloc(const tc_pool* pool) {
+    return pool->alignment > TC_POOL_MALLOC_ALIGN;
+}
+
+bool tc_pool_block_reallocable(const tc_pool* pool) {
+    return !(pool->flags & TC_POOL_HUGE_PAGES) && !needs_aligned_alloc(pool);
+}
+
+void* tc_pool_block_alloc(const tc_pool* pool, size_t size) {
+    if (size == 0) size = 1;
+
+    if (pool->flags & TC_POOL_HUGE_PAGES) {
+        return huge_alloc(size);
+    }
+    if (needs_aligned_alloc(pool)) {
+#ifdef _WIN32
+        return _aligned_malloc(size, pool->alignment);
+#else
+        void* p = NULL;
+        if (posix_memalign(&p, pool->alignment, size) != 0) return NULL;
+        return p;
+#endif
+    }
+    return malloc(size);
+}
+
+void tc_pool_block_free(const tc_pool* pool, void* block, size_t size) {
+    if (!block) return;
+
+    if (pool->flags & TC_POOL_HUGE_PAGES) {
+        huge_free(block, size);
+        return;
+    }
+#ifdef _WIN32
+    if (needs_aligned_alloc(pool)) {
+        _aligned_free(block);
+        return;
+    }
+#endif
+    free(block);
+}
@@ -0,0 +1,264 @@
+// tc_pool_mt.cpp - Concurrent object pool implementation
+#include <tcbase/tc_pool_mt.h>
+#include <tcbase/tc_pool.h>
+#include <tcbase/tc_log.h>
+
+#include <atomic>
+#include <cstring>
+#include <new>
+
+// ============================================================================
+// Internal structures
+// ============================================================================
+
+namespace {
+
+constexpr uint32_t NIL = UINT32_MAX;
+
+// Slot word: generation in the high half, TC_SLOT_OCCUPIED bit in the low half
+inline uint64_t slot_word(uint32_t generation, uint32_t state) {
+    return (uint64_t(generation) << 32) | state;
+}
+
+// Free list head: ABA tag in the high half, slot index in the low half
+inline uint64_t head_word(uint32_t tag, uint32_t index) {
+    return (uint64_t(tag) << 32) | index;
+}
+
+struct mt_page {
+    std::atomic<uint64_t>* slots;  // Slot words
+    std::atomic<uint32_t>* next;   // Free list links
+    char* items;                   // page_items * item_size bytes
+};
+
+} // namespace
+
+struct tc_pool_mt {
+    size_t item_size;
+    uint32_t page_shift;
+    uint32_t page_count;                // Page table length
+    uint32_t max_capacity;
+    std::atomic<mt_page*>* pages;       // Page table, entries installed once
+    std::atomic<uint64_t> free_head;    // Tagged free list head
+    std::atomic<uint32_t> high_water;   // Slots ever handed out from fresh space
+    std::atomic<uint32_t> count;
+};
+
+// ============================================================================
+// Internal helpers
+// ============================================================================
+
+static mt_page* page_create(const tc_pool_mt* pool) {
+    uint32_t page_items = 1u << pool->page_shift;
+
+    mt_page* page = new (std::nothrow) mt_page;
+    if (!page) return nullptr;
+
+    page->slots = new (std::nothrow) std::atomic<uint64_t>[page_items];
+    page->next = new (std::nothrow) std::atomic<uint32_t>[page_items];
+    page->items = new (std::nothrow) char[page_items * pool->item_size];
+    if (!page->slots || !page->next || !page->items) {
+        delete[] page->slots;
+        delete[] page->next;
+        delete[] page->items;
+        delete page;
+        return nullptr;
+    }
+
+    for (uint32_t i = 0; i < page_items; i++) {
+        page->slots[i].store(slot_word(1, TC_SLOT_FREE), std::memory_order_relaxed);
+        page->next[i].store(NIL, std::memory_order_relaxed);
+    }
+    return page;
+}
+
+static void page_destroy(mt_page* page) {
+    if (!page) return;
+    delete[] page->slots;
+    delete[] page->next;
+    delete[] page->items;
+    delete page;
+}
+
+// Page holding index, or NULL if it was never installed
+static inline mt_page* page_of(const tc_pool_mt* pool, uint32_t index) {
+    return pool->pages[index >> pool->page_shift].load(std::memory_order_acquire);
+}
+
+static inline uint32_t offset_of(const tc_pool_mt* pool, uint32_t index) {
+    return index & ((1u << pool->page_shift) - 1);
+}
+
+// Page holding index, installing it if needed. Losers of the install race
+// discard their page and use the winner's.
+static mt_page* page_ensure(tc_pool_mt* pool, uint32_t index) {
+    std::atomic<mt_page*>& entry = pool->pages[index >> pool->page_shift];
+    mt_page* page = entry.load(std::memory_order_acquire);
+    if (page) return page;
+
+    mt_page* fresh = page_create(pool);
+    if (!fresh) {
+        tc_log(TC_LOG_ERROR, "tc_pool_mt: failed to allocate page");
+        return nullptr;
+    }
+    if (entry.compare_exchange_strong(page, fresh, std::memory_order_acq_rel, std::memory_order_acquire)) {
+        return fresh;
+    }
+    page_destroy(fresh);
+    return page;
+}
+
+static uint32_t free_list_pop(tc_pool_mt* pool) {
+    uint64_t head = pool->free_head.load(std::memory_order_acquire);
+    for (;;) {
+        uint32_t index = uint32_t(head);
+        if (index == NIL) return NIL;
+
+        // Links of free slots live in installed pages, which are never unmapped.
+        // A stale read here is caught by the tag on the CAS below.
+        uint32_t next = page_of(pool, index)->next[offset_of(pool, index)].load(std::memory_order_relaxed);
+        uint64_t desired = head_word(uint32_t(head >> 32) + 1, next);
+        if (pool->free_head.compare_exchange_weak(head, desired, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            return index;
+        }
+    }
+}
+
+static void free_list_push(tc_pool_mt* pool, mt_page* page, uint32_t index) {
+    std::atomic<uint32_t>& link = page->next[offset_of(pool, index)];
+    uint64_t head = pool->free_head.load(std::memory_order_relaxed);
+    for (;;) {
+        link.store(uint32_t(head), std::memory_order_relaxed);
+        uint64_t desired = head_word(uint32_t(head >> 32) + 1, index);
+        if (pool->free_head.compare_exchange_weak(head, desired, std::memory_order_release, std::memory_order_relaxed)) {
+            return;
+        }
+    }
+}
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+tc_pool_mt* tc_pool_mt_new(size_t item_size, uint32_t max_capacity) {
+    if (item_size == 0) return nullptr;
+    if (max_capacity == 0) max_capacity = TC_POOL_MT_DEFAULT_MAX_CAPACITY;
+    if (max_capacity == UINT32_MAX) max_capacity = UINT32_MAX - 1;  // UINT32_MAX is the invalid index
+
+    tc_pool_mt* pool = new (std::nothrow) tc_pool_mt;
+    if (!pool) return nullptr;
+
+    size_t fit = TC_POOL_DEFAULT_PAGE_BYTES / item_size;
+    uint32_t page_items = fit > 0 ? uint32_t(fit) : 1;
+    pool->page_shift = 0;
+    while (pool->page_shift < 24 && (1u << pool->page_shift) < page_items) {
+        pool->page_shift++;
+    }
+
+    pool->item_size = item_size;
+    pool->max_capacity = max_capacity;
+    pool->page_count = uint32_t((uint64_t(max_capacity) + (1u << pool->page_shift) - 1) >> pool->page_shift);
+    pool->pages = new (std::nothrow) std::atomic<mt_page*>[pool->page_count];
+    if (!pool->pages) {
+        delete pool;
+        return nullptr;
+    }
+    for (uint32_t p = 0; p < pool->page_count; p++) {
+        pool->pages[p].store(nullptr, std::memory_order_relaxed);
+    }
+
+    pool->free_head.store(head_word(0, NIL), std::memory_order_relaxed);
+    pool->high_water.store(0, std::memory_order_relaxed);
+    pool->count.store(0, std::memory_order_relaxed);
+    return pool;
+}
+
+void tc_pool_mt_free(tc_pool_mt* pool) {
+    if (!pool) return;
+
+    for (uint32_t p = 0; p < pool->page_count; p++) {
+        page_destroy(pool->pages[p].load(std::memory_order_relaxed));
+    }
+    delete[] pool->pages;
+    delete pool;
+}
+
+// ============================================================================
+// Operations
+// ============================================================================
+
+tc_handle tc_pool_mt_alloc(tc_pool_mt* pool) {
+    if (!pool) return TC_HANDLE_INVALID;
+
+    mt_page* page = nullptr;
+    uint32_t index = free_list_pop(pool);
+    if (index != NIL) {
+        page = page_of(pool, index);
+    } else {
+        // Free list empty: claim never-used space
+        index = pool->high_water.fetch_add(1, std::memory_order_relaxed);
+        if (index >= pool->max_capacity) {
+            pool->high_water.fetch_sub(1, std::memory_order_relaxed);
+            tc_log(TC_LOG_ERROR, "tc_pool_mt: max capacity %u reached", pool->max_capacity);
+            return TC_HANDLE_INVALID;
+        }
+        // On failure the claimed index is abandoned: handing it back could
+        // race with claims above it.
+        page = page_ensure(pool, index);
+        if (!page) return TC_HANDLE_INVALID;
+    }
+
+    uint32_t offset = offset_of(pool, index);
+    std::memset(page->items + size_t(offset) * pool->item_size, 0, pool->item_size);
+
+    // Publish: readers that see the occupied word also see the zeroed item
+    std::atomic<uint64_t>& slot = page->slots[offset];
+    uint32_t generation = uint32_t(slot.load(std::memory_order_relaxed) >> 32);
+    slot.store(slot_word(generation, TC_SLOT_OCCUPIED), std::memory_order_release);
+    pool->count.fetch_add(1, std::memory_order_relaxed);
+
+    tc_handle h;
+    h.index = index;
+    h.generation = generation;
+    return h;
+}
+
+bool tc_pool_mt_free_slot(tc_pool_mt* pool, tc_handle h) {
+    if (!pool || h.index >= pool->max_capacity) return false;
+
+    mt_page* page = page_of(pool, h.index);
+    if (!page) return false;
+
+    // Only one of several racing frees wins the transition
+    uint64_t expected = slot_word(h.generation, TC_SLOT_OCCUPIED);
+    uint64_t desired = slot_word(h.generation + 1, TC_SLOT_FREE);
+    if (!page->slots[offset_of(pool, h.index)].compare_exchange_strong(
+            expected, desired, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+        return false;
+    }
+
+    pool->count.fetch_sub(1, std::memory_order_relaxed);
+    free_list_push(pool, page, h.index);
+    return true;
+}
+
+bool tc_pool_mt_is_valid(const tc_pool_mt* pool, tc_handle h) {
+    if (!pool || h.index >= pool->max_capacity) return false;
+
+    const mt_page* page = page_of(pool, h.index);
+    if (!page) return false;
+
+    uint64_t word = page->slots[offset_of(pool, h.index)].load(std::memory_order_acquire);
+    return word == slot_word(h.generation, TC_SLOT_OCCUPIED);
+}
+
+void* tc_pool_mt_get(const tc_pool_mt* pool, tc_handle h) {
+    if (!tc_pool_mt_is_valid(pool, h)) return nullptr;
+
+    const mt_page* page = page_of(pool, h.index);
+    return page->items + size_t(offset_of(pool, h.index)) * pool->item_size;
+}
+
+uint32_t tc_pool_mt_count(const tc_pool_mt* pool) {
+    return pool ? pool->count.load(std::memory_order_relaxed) : 0;
+}
@@ -0,0 +1,170 @@
+// tc_pool_parallel.cpp - Parallel chunked iteration over tc_pool
+#include <tcbase/tc_pool.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ============================================================================
+// Internal structures
+// ============================================================================
+
+namespace {
+
+constexpr uint32_t MAX_WORKERS = 256;
+constexpr uint32_t MIN_DEFAULT_CHUNK = 64;
+
+struct ParallelJob {
+    tc_pool* pool;
+    tc_pool_chunk_fn callback;
+    void* user_data;
+    uint32_t range;
+    uint32_t chunk_size;
+    uint32_t chunk_count;
+    std::atomic<uint32_t> next_chunk{0};
+    std::atomic<uint32_t> done_chunks{0};
+};
+
+// Claim chunks until none are left; returns true if this call finished the job
+bool run_chunks(ParallelJob& job) {
+    bool finished = false;
+    for (;;) {
+        uint32_t chunk = job.next_chunk.fetch_add(1, std::memory_order_relaxed);
+        if (chunk >= job.chunk_count) break;
+
+        uint32_t begin = chunk * job.chunk_size;
+        uint32_t end = std::min(job.range, begin + job.chunk_size);
+        job.callback(job.pool, begin, end, job.user_data);
+
+        if (job.done_chunks.fetch_add(1, std::memory_order_acq_rel) + 1 == job.chunk_count) {
+            finished = true;
+        }
+    }
+    return finished;
+}
+
+// Persistent helper threads. One job runs at a time; the calling thread
+// always takes part, helpers join up to the requested count.
+class WorkerPool {
+public:
+    static WorkerPool& instance() {
+        static WorkerPool pool;
+        return pool;
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (std::thread& t : threads_) {
+            t.join();
+        }
+    }
+
+    // Returns false if another job is running (caller should run serially)
+    bool try_run(ParallelJob& job, uint32_t helpers) {
+        std::unique_lock<std::mutex> job_lock(job_mutex_, std::try_to_lock);
+        if (!job_lock.owns_lock()) return false;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            while (threads_.size() < helpers) {
+                threads_.emplace_back([this]() { worker_loop(); });
+            }
+            job_ = &job;
+            job_seq_++;
+            wanted_helpers_ = helpers;
+            joined_helpers_ = 0;
+        }
+        wake_.notify_all();
+
+        run_chunks(job);
+
+        // Helpers still inside run_chunks reference job; wait them out
+        std::unique_lock<std::mutex> lock(mutex_);
+        finished_.wait(lock, [&]() {
+            return active_helpers_ == 0 &&
+                   job.done_chunks.load(std::memory_order_acquire) == job.chunk_count;
+        });
+        job_ = nullptr;
+        return true;
+    }
+
+private:
+    void worker_loop() {
+        uint64_t seen_seq = 0;
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;) {
+            // Join each job at most once
+            wake_.wait(lock, [&]() {
+                return stop_ || (job_ && job_seq_ != seen_seq && joined_helpers_ < wanted_helpers_);
+            });
+            if (stop_) return;
+
+            ParallelJob* job = job_;
+            seen_seq = job_seq_;
+            joined_helpers_++;
+            active_helpers_++;
+            lock.unlock();
+
+            run_chunks(*job);
+
+            lock.lock();
+            active_helpers_--;
+            finished_.notify_all();
+        }
+    }
+
+    std::mutex job_mutex_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable finished_;
+    std::vector<std::thread> threads_;
+    ParallelJob* job_ = nullptr;
+    uint64_t job_seq_ = 0;
+    uint32_t wanted_helpers_ = 0;
+    uint32_t joined_helpers_ = 0;
+    uint32_t active_helpers_ = 0;
+    bool stop_ = false;
+};
+
+} // namespace
+
+// ============================================================================
+// Parallel iteration
+// ============================================================================
+
+void tc_pool_parallel_foreach(tc_pool* pool, tc_pool_chunk_fn callback, void* user_data,
+                              uint32_t chunk_size, uint32_t thread_count) {
+    if (!pool || !callback) return;
+
+    uint32_t range = tc_pool_dense_items(pool) ? pool->count : pool->capacity;
+    if (range == 0) return;
+
+    if (thread_count == 0) {
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+    thread_count = std::min(thread_count, MAX_WORKERS);
+
+    if (chunk_size == 0) {
+        chunk_size = std::max(MIN_DEFAULT_CHUNK, range / (thread_count * 4));
+    }
+
+    ParallelJob job;
+    job.pool = pool;
+    job.callback = callback;
+    job.user_data = user_data;
+    job.range = range;
+    job.chunk_size = chunk_size;
+    job.chunk_count = uint32_t((uint64_t(range) + chunk_size - 1) / chunk_size);
+
+    uint32_t helpers = std::min(thread_count, job.chunk_count) - 1;
+    if (helpers == 0 || !WorkerPool::instance().try_run(job, helpers)) {
+        run_chunks(job);
+    }
+}
@@ -0,0 +1,384 @@
+// tc_pool_snapshot.c - Binary snapshot/restore of tc_pool
+#include <tcbase/tc_pool.h>
+#include <tcbase/tc_log.h>
+#include "tc_file_map.h"
+#include "tc_pool_internal.h"
+#include <stdio.h>
+#include <string.h>
+
+// 64-bit file offsets
+#ifdef _WIN32
+#define tc_fseek _fseeki64
+#define tc_ftell _ftelli64
+#else
+#define tc_fseek fseeko
+#define tc_ftell ftello
+#endif
+
+// ============================================================================
+// Image format
+// ============================================================================
+//
+// [header][data][generations][occupied][free_list][slot_to_dense][dense_to_slot]
+// Sections start on TC_POOL_IMAGE_ALIGN boundaries (data on the pool's item
+// alignment if larger) so a mapped image can be used in place. Data holds
+// capacity items in slot order, or count items in dense order for
+// TC_POOL_DENSE images, item_stride bytes apart. Integers use the writer's
+// byte order.
+
+#define TC_POOL_IMAGE_MAGIC "TCPL"
+#define TC_POOL_IMAGE_VERSION 2
+#define TC_POOL_IMAGE_BYTE_ORDER 0x01020304u
+#define TC_POOL_IMAGE_ALIGN 64
+
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t flags;
+    uint64_t item_size;
+    uint64_t item_stride;
+    uint32_t capacity;
+    uint32_t count;
+    uint32_t free_count;
+    uint32_t page_shift;
+    uint32_t generation_base;
+    uint32_t alignment;
+    uint64_t data_offset;
+    uint64_t generations_offset;
+    uint64_t occupied_offset;
+    uint64_t free_list_offset;
+    uint64_t dense_offset;
+    uint64_t total_size;
+} tc_pool_image_header;
+
+// ============================================================================
+// Internal helpers
+// ============================================================================
+
+static uint64_t align_to(uint64_t v, uint64_t alignment) {
+    return (v + alignment - 1) & ~(alignment - 1);
+}
+
+static uint64_t align_up(uint64_t v) {
+    return align_to(v, TC_POOL_IMAGE_ALIGN);
+}
+
+static uint64_t image_data_size(const tc_pool_image_header* hdr) {
+    uint32_t items = (hdr->flags & TC_POOL_DENSE) ? hdr->count : hdr->capacity;
+    return (uint64_t)items * hdr->item_stride;
+}
+
+// Fill section offsets from the size fields
+static void image_layout(tc_pool_image_header* hdr) {
+    uint64_t cursor = align_up(sizeof(tc_pool_image_header));
+    if (hdr->alignment > TC_POOL_IMAGE_ALIGN) cursor = align_to(cursor, hdr->alignment);
+    hdr->data_offset = cursor;
+    cursor = align_up(cursor + image_data_size(hdr));
+    hdr->generations_offset = cursor;
+    cursor = align_up(cursor + (uint64_t)hdr->capacity * sizeof(uint32_t));
+    hdr->occupied_offset = cursor;
+    cursor = align_up(cursor + (uint64_t)TC_POOL_WORD_COUNT(hdr->capacity) * sizeof(uint64_t));
+    hdr->free_list_offset = cursor;
+    cursor = align_up(cursor + (uint64_t)hdr->free_count * sizeof(uint32_t));
+    hdr->dense_offset = cursor;
+    if (hdr->flags & TC_POOL_DENSE) {
+        cursor += 2 * (uint64_t)hdr->capacity * sizeof(uint32_t);
+    }
+    hdr->total_size = cursor;
+}
+
+static bool header_is_valid(const tc_pool_image_header* hdr, uint64_t file_size) {
+    if (memcmp(hdr->magic, TC_POOL_IMAGE_MAGIC, 4) != 0) {
+        tc_log(TC_LOG_ERROR, "tc_pool: not a pool image");
+        return false;
+    }
+    if (hdr->version != TC_POOL_IMAGE_VERSION || hdr->byte_order != TC_POOL_IMAGE_BYTE_ORDER) {
+        tc_log(TC_LOG_ERROR, "tc_pool: unsupported pool image version %u", hdr->version);
+        return false;
+    }
+
+    tc_pool_image_header expected = *hdr;
+    image_layout(&expected);
+    bool layout_ok = expected.data_offset == hdr->data_offset &&
+                     expected.generations_offset == hdr->generations_offset &&
+                     expected.occupied_offset == hdr->occupied_offset &&
+                     expected.free_list_offset == hdr->free_list_offset &&
+                     expected.dense_offset == hdr->dense_offset &&
+                     expected.total_size == hdr->total_size;
+    // Only paged pools have pages; the shift must be usable in 32-bit shifts
+    // and the slots must fill whole pages
+    bool pages_ok = (hdr->flags & TC_POOL_PAGED)
+        ? hdr->page_shift < 32 && (hdr->capacity & ((1u << hdr->page_shift) - 1)) == 0
+        : hdr->page_shift == 0;
+    if (hdr->item_size == 0 || hdr->item_stride < hdr->item_size ||
+        hdr->alignment & (hdr->alignment - 1) || hdr->alignment > TC_POOL_MAX_ALIGNMENT ||
+        hdr->count > hdr->capacity || hdr->free_count > hdr->capacity ||
+        !layout_ok || !pages_ok || hdr->total_size > file_size) {
+        tc_log(TC_LOG_ERROR, "tc_pool: corrupt pool image");
+        return false;
+    }
+    return true;
+}
+
+// Check the restored arrays against each other: every index later used to
+// address slots or dense items must be in range
+static bool pool_arrays_valid(const tc_pool* pool) {
+    uint32_t occupied = 0;
+    for (uint32_t i = 0; i < pool->capacity; i++) {
+        if (tc_pool_slot_occupied(pool, i)) occupied++;
+    }
+    bool ok = occupied == pool->count;
+
+    for (uint32_t i = 0; ok && i < pool->free_count; i++) {
+        uint32_t slot = pool->free_list[i];
+        ok = slot < pool->capacity && !tc_pool_slot_occupied(pool, slot);
+    }
+
+    // Dense maps are inverses over [0, count)
+    if (pool->slot_to_dense) {
+        for (uint32_t d = 0; ok && d < pool->count; d++) {
+            uint32_t slot = pool->dense_to_slot[d];
+            ok = slot < pool->capacity && tc_pool_slot_occupied(pool, slot) &&
+                 pool->slot_to_dense[slot] == d;
+        }
+    }
+
+    if (!ok) {
+        tc_log(TC_LOG_ERROR, "tc_pool: corrupt pool image");
+    }
+    return ok;
+}
+
+// Write a section at its offset, padding from the current position
+static bool write_at(FILE* f, uint64_t* pos, uint64_t offset, const void* src, uint64_t size) {
+    static const char zeros[TC_POOL_IMAGE_ALIGN] = {0};
+    while (*pos < offset) {
+        uint64_t pad = offset - *pos;
+        if (pad > sizeof(zeros)) pad = sizeof(zeros);
+        if (fwrite(zeros, 1, (size_t)pad, f) != pad) return false;
+        *pos += pad;
+    }
+    if (size > 0 && fwrite(src, 1, (size_t)size, f) != size) return false;
+    *pos += size;
+    return true;
+}
+
+static bool read_at(FILE* f, uint64_t offset, void* dst, uint64_t size) {
+    if (size == 0) return true;
+    if (tc_fseek(f, (int64_t)offset, SEEK_SET) != 0) return false;
+    return fread(dst, 1, (size_t)size, f) == size;
+}
+
+// ============================================================================
+// Snapshot
+// ============================================================================
+
+bool tc_pool_snapshot(const tc_pool* pool, const char* path) {
+    if (!pool || !path) return false;
+
+    tc_pool_image_header hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.magic, TC_POOL_IMAGE_MAGIC, 4);
+    hdr.version = TC_POOL_IMAGE_VERSION;
+    hdr.byte_order = TC_POOL_IMAGE_BYTE_ORDER;
+    hdr.flags = pool->flags & (TC_POOL_DENSE | TC_POOL_PAGED | TC_POOL_NO_ZERO | TC_POOL_HUGE_PAGES);
+    hdr.item_size = pool->item_size;
+    hdr.item_stride = pool->item_stride;
+    hdr.alignment = (uint32_t)pool->alignment;
+    hdr.capacity = pool->capacity;
+    hdr.count = pool->count;
+    hdr.free_count = pool->free_count;
+    hdr.page_shift = pool->page_shift;
+    hdr.generation_base = pool->generation_base;
+    image_layout(&hdr);
+
+    FILE* f = fopen(path, "wb");
+    if (!f) {
+        tc_log(TC_LOG_ERROR, "tc_pool: cannot open '%s' for writing", path);
+        return false;
+    }
+
+    uint64_t pos = 0;
+    bool ok = write_at(f, &pos, 0, &hdr, sizeof(hdr));
+
+    if (pool->pages) {
+        // Paged: pages are written back to back; released pages become zeros
+        size_t page_bytes = ((size_t)1 << pool->page_shift) * pool->item_stride;
+        for (uint32_t p = 0; ok && p < pool->page_count; p++) {
+            uint64_t offset = hdr.data_offset + (uint64_t)p * page_bytes;
+            if (pool->pages[p]) {
+                ok = write_at(f, &pos, offset, pool->pages[p], page_bytes);
+            } else {
+                ok = write_at(f, &pos, offset + page_bytes, NULL, 0);
+            }
+        }
+    } else {
+        ok = ok && write_at(f, &pos, hdr.data_offset, pool->data, image_data_size(&hdr));
+    }
+
+    ok = ok && write_at(f, &pos, hdr.generations_offset, pool->generations,
+                        (uint64_t)hdr.capacity * sizeof(uint32_t));
+    ok = ok && write_at(f, &pos, hdr.occupied_offset, pool->occupied,
+                        (uint64_t)TC_POOL_WORD_COUNT(hdr.capacity) * sizeof(uint64_t));
+    ok = ok && write_at(f, &pos, hdr.free_list_offset, pool->free_list,
+                        (uint64_t)hdr.free_count * sizeof(uint32_t));
+    if (hdr.flags & TC_POOL_DENSE) {
+        ok = ok && write_at(f, &pos, hdr.dense_offset, pool->slot_to_dense,
+                            (uint64_t)hdr.capacity * sizeof(uint32_t));
+        ok = ok && write_at(f, &pos, pos, pool->dense_to_slot,
+                            (uint64_t)hdr.capacity * sizeof(uint32_t));
+    }
+    ok = ok && write_at(f, &pos, hdr.total_size, NULL, 0);
+
+    if (fclose(f) != 0) ok = false;
+    if (!ok) {
+        tc_log(TC_LOG_ERROR, "tc_pool: failed to write snapshot '%s'", path);
+    }
+    return ok;
+}
+
+// ============================================================================
+// Restore
+// ============================================================================
+
+static bool restore_copy(tc_pool* pool, const char* path) {
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        tc_log(TC_LOG_ERROR, "tc_pool: cannot open '%s'", path);
+        return false;
+    }
+
+    tc_pool_image_header hdr;
+    bool ok = fread(&hdr, 1, sizeof(hdr), f) == sizeof(hdr);
+    if (ok) {
+        tc_fseek(f, 0, SEEK_END);
+        int64_t file_size = (int64_t)tc_ftell(f);
+        ok = file_size >= 0 && header_is_valid(&hdr, (uint64_t)file_size);
+    }
+    if (!ok) {
+        fclose(f);
+        return false;
+    }
+
+    memset(pool, 0, sizeof(tc_pool));
+    pool->item_size = (size_t)hdr.item_size;
+    pool->item_stride = (size_t)hdr.item_stride;
+    pool->alignment = hdr.alignment;
+    pool->flags = hdr.flags;
+    pool->capacity = hdr.capacity;
+    pool->meta_capacity = hdr.capacity;
+    pool->count = hdr.count;
+    pool->free_count = hdr.free_count;
+    pool->page_shift = hdr.page_shift;
+    pool->generation_base = hdr.generation_base;
+
+    // One allocation and one read per section
+    uint32_t cap = hdr.capacity > 0 ? hdr.capacity : 1;
+    pool->generations = (uint32_t*)malloc(cap * sizeof(uint32_t));
+    pool->occupied = (uint64_t*)malloc(TC_POOL_WORD_COUNT(cap) * sizeof(uint64_t));
+    pool->free_list = (uint32_t*)malloc(cap * sizeof(uint32_t));
+    ok = pool->generations && pool->occupied && pool->free_list;
+
+    ok = ok && read_at(f, hdr.generations_offset, pool->generations, (uint64_t)hdr.capacity * sizeof(uint32_t));
+    ok = ok && read_at(f, hdr.occupied_offset, pool->occupied,
+                       (uint64_t)TC_POOL_WORD_COUNT(hdr.capacity) * sizeof(uint64_t));
+    ok = ok && read_at(f, hdr.free_list_offset, pool->free_list, (uint64_t)hdr.free_count * sizeof(uint32_t));
+
+    if (ok && (hdr.flags & TC_POOL_DENSE)) {
+        pool->slot_to_dense = (uint32_t*)malloc(cap * sizeof(uint32_t));
+        pool->dense_to_slot = (uint32_t*)malloc(cap * sizeof(uint32_t));
+        ok = pool->slot_to_dense && pool->dense_to_slot;
+        ok = ok && read_at(f, hdr.dense_offset, pool->slot_to_dense, (uint64_t)hdr.capacity * sizeof(uint32_t));
+        ok = ok && read_at(f, hdr.dense_offset + (uint64_t)hdr.capacity * sizeof(uint32_t),
+                           pool->dense_to_slot, (uint64_t)hdr.capacity * sizeof(uint32_t));
+    }
+    ok = ok && pool_arrays_valid(pool);
+
+    if (ok && (hdr.flags & TC_POOL_PAGED)) {
+        // Only pages holding live items get memory
+        uint32_t page_items = 1u << hdr.page_shift;
+        size_t page_bytes = (size_t)page_items * pool->item_stride;
+        pool->page_count = hdr.capacity >> hdr.page_shift;
+        if (pool->page_count > 0) {
+            pool->pages = (void**)calloc(pool->page_count, sizeof(void*));
+            pool->page_live = (uint32_t*)calloc(pool->page_count, sizeof(uint32_t));
+            ok = pool->pages && pool->page_live;
+        }
+        for (uint32_t p = 0; ok && p < pool->page_count; p++) {
+            for (uint32_t i = p * page_items; i < (p + 1) * page_items; i++) {
+                if (tc_pool_slot_occupied(pool, i)) pool->page_live[p]++;
+            }
+            if (pool->page_live[p] == 0) continue;
+            pool->pages[p] = tc_pool_block_alloc(pool, page_bytes);
+            ok = pool->pages[p] && read_at(f, hdr.data_offset + (uint64_t)p * page_bytes, pool->pages[p], page_bytes);
+        }
+    } else if (ok) {
+        uint64_t data_size = image_data_size(&hdr);
+        uint64_t alloc_items = hdr.capacity > 0 ? hdr.capacity : 1;
+        pool->data_bytes = (size_t)alloc_items * pool->item_stride;
+        pool->data = tc_pool_block_alloc(pool, pool->data_bytes);
+        ok = pool->data != NULL;
+        if (ok) memset(pool->data, 0, pool->data_bytes);
+        ok = ok && read_at(f, hdr.data_offset, pool->data, data_size);
+    }
+
+    fclose(f);
+    if (!ok) {
+        tc_log(TC_LOG_ERROR, "tc_pool: failed to read snapshot '%s'", path);
+        tc_pool_free(pool);
+    }
+    return ok;
+}
+
+static bool restore_mapped(tc_pool* pool, const char* path) {
+    size_t size = 0;
+    void* base = tc_file_map_readonly(path, &size);
+    if (!base) return false;
+
+    const tc_pool_image_header* hdr = (const tc_pool_image_header*)base;
+    if (size < sizeof(*hdr) || !header_is_valid(hdr, size)) {
+        tc_file_unmap(base, size);
+        return false;
+    }
+
+    // Arrays point into the read-only image. Paged images are laid out in
+    // slot order, so they are viewed as flat pools.
+    char* bytes = (char*)base;
+    memset(pool, 0, sizeof(tc_pool));
+    pool->item_size = (size_t)hdr->item_size;
+    pool->item_stride = (size_t)hdr->item_stride;
+    pool->alignment = hdr->alignment;
+    pool->flags = (hdr->flags & TC_POOL_DENSE) | TC_POOL_MAPPED;
+    pool->capacity = hdr->capacity;
+    pool->meta_capacity = hdr->capacity;
+    pool->count = hdr->count;
+    pool->free_count = hdr->free_count;
+    pool->generation_base = hdr->generation_base;
+    pool->data = bytes + hdr->data_offset;
+    pool->generations = (uint32_t*)(bytes + hdr->generations_offset);
+    pool->occupied = (uint64_t*)(bytes + hdr->occupied_offset);
+    pool->free_list = (uint32_t*)(bytes + hdr->free_list_offset);
+    if (hdr->flags & TC_POOL_DENSE) {
+        pool->slot_to_dense = (uint32_t*)(bytes + hdr->dense_offset);
+        pool->dense_to_slot = pool->slot_to_dense + hdr->capacity;
+    }
+    pool->mapping = base;
+    pool->mapping_size = size;
+    if (!pool_arrays_valid(pool)) {
+        tc_file_unmap(base, size);
+        memset(pool, 0, sizeof(tc_pool));
+        return false;
+    }
+    return true;
+}
+
+bool tc_pool_restore(tc_pool* pool, const char* path, uint32_t restore_flags) {
+    if (!pool || !path) return false;
+
+    if (restore_flags & TC_POOL_RESTORE_MAP) {
+        return restore_mapped(pool, path);
+    }
+    return restore_copy(pool, path);
+}
+
@@ -0,0 +1,372 @@
+// tc_resource_loader.cpp - Asynchronous resource loading implementation
+#include <tcbase/tc_resource_loader.h>
+#include <tcbase/tc_log.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <new>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ============================================================================
+// Internal structures
+// ============================================================================
+
+namespace {
+
+struct LoadCallback {
+    tc_resource_loaded_fn fn;
+    void* user_data;
+};
+
+// One per requested UUID, stored in the loader's tc_resource_map.
+// All fields are guarded by the loader mutex.
+struct LoadEntry {
+    std::string uuid;
+    void* resource = nullptr;
+    tc_load_state state = TC_LOAD_PENDING;
+    bool running = false;
+    bool removed = false;
+    int32_t priority = 0;
+    uint64_t queue_seq = 0;         // Sequence of the live queue item
+    uint32_t refs = 1;              // Map + queue items + running decodes + waiters
+    std::vector<LoadCallback> callbacks;
+};
+
+// Reprioritizing pushes a new item; stale items are skipped by sequence
+struct QueueItem {
+    int32_t priority;
+    uint64_t seq;
+    LoadEntry* entry;
+
+    bool operator<(const QueueItem& other) const {
+        if (priority != other.priority) return priority < other.priority;
+        return seq > other.seq;     // FIFO within a priority
+    }
+};
+
+struct Delivery {
+    LoadCallback callback;
+    LoadEntry* entry;
+};
+
+} // namespace
+
+struct tc_resource_loader {
+    tc_resource_decode_fn decode;
+    tc_resource_free_fn destructor;
+    void* user_data;
+
+    std::mutex mutex;
+    std::condition_variable work_ready;
+    std::condition_variable entry_done;
+    tc_resource_map* entries;       // uuid -> LoadEntry*
+    std::priority_queue<QueueItem> queue;
+    std::vector<Delivery> deliveries;
+    uint64_t next_seq = 0;
+    size_t pending = 0;
+    bool stop = false;
+    std::vector<std::thread> workers;
+};
+
+namespace {
+
+void release(LoadEntry* entry) {
+    if (--entry->refs == 0) delete entry;
+}
+
+void enqueue(tc_resource_loader* loader, LoadEntry* entry) {
+    entry->queue_seq = ++loader->next_seq;
+    entry->refs++;
+    loader->queue.push({entry->priority, entry->queue_seq, entry});
+    loader->work_ready.notify_one();
+}
+
+void deliver_all(tc_resource_loader* loader, LoadEntry* entry) {
+    for (const LoadCallback& cb : entry->callbacks) {
+        entry->refs++;
+        loader->deliveries.push_back({cb, entry});
+    }
+    entry->callbacks.clear();
+}
+
+// Decode entry with the lock released; returns with the lock held.
+// Returns a result that must be destroyed by the caller, if any.
+void* run_decode(tc_resource_loader* loader, LoadEntry* entry, std::unique_lock<std::mutex>& lock) {
+    entry->running = true;
+    lock.unlock();
+    void* resource = loader->decode(entry->uuid.c_str(), loader->user_data);
+    lock.lock();
+    entry->running = false;
+
+    if (entry->removed) {
+        return resource;
+    }
+    entry->resource = resource;
+    entry->state = resource ? TC_LOAD_READY : TC_LOAD_FAILED;
+    loader->pending--;
+    deliver_all(loader, entry);
+    loader->entry_done.notify_all();
+    return nullptr;
+}
+
+void destroy_resource(tc_resource_loader* loader, void* resource) {
+    if (resource && loader->destructor) loader->destructor(resource);
+}
+
+void worker_loop(tc_resource_loader* loader) {
+    std::unique_lock<std::mutex> lock(loader->mutex);
+    for (;;) {
+        loader->work_ready.wait(lock, [loader]() { return loader->stop || !loader->queue.empty(); });
+        if (loader->stop) return;
+
+        QueueItem item = loader->queue.top();
+        loader->queue.pop();
+        LoadEntry* entry = item.entry;
+
+        bool stale = item.seq != entry->queue_seq || entry->running ||
+                     entry->removed || entry->state != TC_LOAD_PENDING;
+        if (stale) {
+            release(entry);
+            continue;
+        }
+
+        void* orphan = run_decode(loader, entry, lock);
+        release(entry);
+        if (orphan) {
+            lock.unlock();
+            destroy_resource(loader, orphan);
+            lock.lock();
+        }
+    }
+}
+
+LoadEntry* find_entry(tc_resource_loader* loader, const char* uuid) {
+    return static_cast<LoadEntry*>(tc_resource_map_get(loader->entries, uuid));
+}
+
+} // namespace
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+tc_resource_loader* tc_resource_loader_new(
+    tc_resource_decode_fn decode,
+    tc_resource_free_fn destructor,
+    void* user_data,
+    uint32_t worker_count
+) {
+    if (!decode) return nullptr;
+
+    tc_resource_loader* loader = new (std::nothrow) tc_resource_loader;
+    if (!loader) return nullptr;
+
+    loader->entries = tc_resource_map_new(nullptr);
+    if (!loader->entries) {
+        delete loader;
+        return nullptr;
+    }
+    loader->decode = decode;
+    loader->destructor = destructor;
+    loader->user_data = user_data;
+
+    if (worker_count == 0) {
+        unsigned hw = std::thread::hardware_concurrency();
+        worker_count = hw > 1 ? hw - 1 : 1;
+    }
+    try {
+        for (uint32_t i = 0; i < worker_count; i++) {
+            loader->workers.emplace_back(worker_loop, loader);
+        }
+    } catch (...) {
+        tc_log(TC_LOG_WARN, "tc_resource_loader: started %zu of %u workers",
+               loader->workers.size(), worker_count);
+        if (loader->workers.empty()) {
+            tc_resource_map_free(loader->entries);
+            delete loader;
+            return nullptr;
+        }
+    }
+    return loader;
+}
+
+static bool free_entry(const char* uuid, void* value, void* user_data) {
+    (void)uuid;
+    tc_resource_loader* loader = static_cast<tc_resource_loader*>(user_data);
+    LoadEntry* entry = static_cast<LoadEntry*>(value);
+    destroy_resource(loader, entry->resource);
+    release(entry);
+    return true;
+}
+
+void tc_resource_loader_free(tc_resource_loader* loader) {
+    if (!loader) return;
+
+    {
+        std::lock_guard<std::mutex> lock(loader->mutex);
+        loader->stop = true;
+    }
+    loader->work_ready.notify_all();
+    for (std::thread& t : loader->workers) {
+        t.join();
+    }
+
+    // Workers are gone: drop the remaining references to entries
+    while (!loader->queue.empty()) {
+        release(loader->queue.top().entry);
+        loader->queue.pop();
+    }
+    for (const Delivery& d : loader->deliveries) {
+        release(d.entry);
+    }
+    tc_resource_map_foreach(loader->entries, free_entry, loader);
+    tc_resource_map_free(loader->entries);
+    delete loader;
+}
+
+// ============================================================================
+// Requests
+// ============================================================================
+
+tc_load_state tc_resource_loader_request(
+    tc_resource_loader* loader,
+    const char* uuid,
+    int32_t priority,
+    tc_resource_loaded_fn callback,
+    void* callback_user_data
+) {
+    if (!loader || !uuid) return TC_LOAD_NONE;
+
+    std::lock_guard<std::mutex> lock(loader->mutex);
+
+    LoadEntry* entry = find_entry(loader, uuid);
+    if (!entry) {
+        entry = new (std::nothrow) LoadEntry;
+        if (!entry) return TC_LOAD_NONE;
+        entry->uuid = uuid;
+        entry->priority = priority;
+        if (!tc_resource_map_add(loader->entries, uuid, entry)) {
+            delete entry;
+            return TC_LOAD_NONE;
+        }
+        loader->pending++;
+        enqueue(loader, entry);
+    } else if (entry->state == TC_LOAD_PENDING && !entry->running && priority > entry->priority) {
+        entry->priority = priority;
+        enqueue(loader, entry);
+    }
+
+    if (callback) {
+        entry->callbacks.push_back({callback, callback_user_data});
+        if (entry->state != TC_LOAD_PENDING) deliver_all(loader, entry);
+    }
+    return entry->state;
+}
+
+size_t tc_resource_loader_dispatch(tc_resource_loader* loader) {
+    if (!loader) return 0;
+
+    std::vector<Delivery> batch;
+    {
+        std::lock_guard<std::mutex> lock(loader->mutex);
+        batch.swap(loader->deliveries);
+    }
+
+    // Entries stay alive through their delivery references. Fields read
+    // here are final once the entry has completed, except removed.
+    size_t count = 0;
+    for (const Delivery& d : batch) {
+        bool removed;
+        {
+            std::lock_guard<std::mutex> lock(loader->mutex);
+            removed = d.entry->removed;
+        }
+        if (!removed) {
+            LoadEntry* e = d.entry;
+            d.callback.fn(e->uuid.c_str(), e->resource, e->state, d.callback.user_data);
+            count++;
+        }
+        std::lock_guard<std::mutex> lock(loader->mutex);
+        release(d.entry);
+    }
+    return count;
+}
+
+bool tc_resource_loader_remove(tc_resource_loader* loader, const char* uuid) {
+    if (!loader || !uuid) return false;
+
+    void* resource = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(loader->mutex);
+        LoadEntry* entry = find_entry(loader, uuid);
+        if (!entry) return false;
+
+        tc_resource_map_remove(loader->entries, uuid);
+        if (entry->state == TC_LOAD_PENDING) loader->pending--;
+        entry->removed = true;
+        entry->callbacks.clear();
+        resource = entry->resource;
+        entry->resource = nullptr;
+        release(entry);
+        loader->entry_done.notify_all();
+    }
+    destroy_resource(loader, resource);
+    return true;
+}
+
+// ============================================================================
+// Queries
+// ============================================================================
+
+tc_load_state tc_resource_loader_state(tc_resource_loader* loader, const char* uuid) {
+    if (!loader || !uuid) return TC_LOAD_NONE;
+
+    std::lock_guard<std::mutex> lock(loader->mutex);
+    LoadEntry* entry = find_entry(loader, uuid);
+    return entry ? entry->state : TC_LOAD_NONE;
+}
+
+void* tc_resource_loader_get(tc_resource_loader* loader, const char* uuid) {
+    if (!loader || !uuid) return nullptr;
+
+    std::lock_guard<std::mutex> lock(loader->mutex);
+    LoadEntry* entry = find_entry(loader, uuid);
+    return entry ? entry->resource : nullptr;
+}
+
+void* tc_resource_loader_wait(tc_resource_loader* loader, const char* uuid) {
+    if (!loader || !uuid) return nullptr;
+
+    std::unique_lock<std::mutex> lock(loader->mutex);
+    LoadEntry* entry = find_entry(loader, uuid);
+    if (!entry) return nullptr;
+
+    entry->refs++;
+    while (entry->state == TC_LOAD_PENDING && !entry->removed) {
+        if (!entry->running) {
+            // Still queued: decode here; the queue item becomes stale
+            void* orphan = run_decode(loader, entry, lock);
+            if (orphan) {
+                lock.unlock();
+                destroy_resource(loader, orphan);
+                lock.lock();
+            }
+        } else {
+            loader->entry_done.wait(lock);
+        }
+    }
+    void* resource = entry->removed ? nullptr : entry->resource;
+    release(entry);
+    return resource;
+}
+
+size_t tc_resource_loader_pending(tc_resource_loader* loader) {
+    if (!loader) return 0;
+
+    std::lock_guard<std::mutex> lock(loader->mutex);
+    return loader->pending;
+}
@@ -1,8 +1,18 @@
 // tc_resource_map.c - Generic hashmap for resources by UUID
 #include <tcbase/tc_resource_map.h>
+#include "tc_resource_map_internal.h"
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TC_MAP_SSE2 1
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
 // Cross-platform strdup
 #ifdef _WIN32
 #define tc_strdup _strdup
@@ -13,30 +23,76 @@
 // ============================================================================
 // Internal structures
 // ============================================================================
-
-#define ENTRY_EMPTY   0
-#define ENTRY_OCCUPIED 1
-#define ENTRY_DELETED  2
+//
+// Swiss-table layout: slots are split into groups of GROUP_SIZE. Each slot
+// has a control byte, either CTRL_EMPTY or the low 7 bits of its key hash
+// (h2). A lookup compares h2 against a whole group of control bytes at
+// once and only inspects entries whose fragment matches.
+//
+// Groups are probed triangularly from h1 = hash >> 7. Instead of
+// tombstones, each group counts the entries that probed past it while
+// full; a lookup stops at the first group with no overflow. Removal
+// decrements those counts along the probe path and frees the slot, so
+// probe chains never degrade with churn.
+//
+// Entries live in a dense array in insertion order; each table slot holds
+// an entry index. Rehashing only rebuilds the small slot arrays, entries
+// never move. Removal leaves a hole (key == NULL) that is squeezed out when
+// the array next needs room, so iteration streams entries in insertion
+// order.
+//
+// Unreferenced entries (refcount 0) with a nonzero cost are linked into an
+// intrusive LRU list by entry index, least recently used first. Zero-cost
+// entries stay off it: evicting them would free nothing. When the total cost of all
+// entries exceeds the budget, entries are evicted from the LRU head.
+
+#define GROUP_SIZE 16
+#define CTRL_EMPTY 0x80
+
+// Grow when count would exceed 7/8 of capacity
+#define MAX_LOAD_NUM 7
+#define MAX_LOAD_DEN 8
+
+// End of an LRU list
+#define LRU_NONE UINT32_MAX
+
+// Slots and entries are addressed with 32-bit indices
+#define MAX_ENTRIES ((size_t)UINT32_MAX)
 
 typedef struct {
-    char* key;
+    char* key;          // NULL for a hole left by removal
     void* value;
-    uint8_t state;
+    uint64_t hash;      // hash_string(key), checked before strcmp
+    size_t cost;        // Bytes charged against the budget
+    uint32_t slot;      // Table slot pointing at this entry
+    uint32_t refcount;  // Holders from tc_resource_map_acquire
+    uint32_t lru_prev;  // LRU neighbours (entry indices) while lru_listed
+    uint32_t lru_next;
 } resource_entry;
 
 struct tc_resource_map {
-    resource_entry* entries;
-    size_t capacity;
+    resource_entry* entries;  // Dense, insertion order, with holes
+    size_t entries_used;      // Entries written, holes included
+    size_t entries_capacity;
+    size_t holes;
+    uint8_t* ctrl;            // Control byte per slot
+    uint32_t* overflow;       // Per group: entries stored past it in their probe sequence
+    uint32_t* slot_entry;     // Entry index per slot
+    size_t capacity;          // Slots, a power of two >= GROUP_SIZE
     size_t count;
-    size_t deleted;
     tc_resource_free_fn destructor;
+    uint32_t lru_head;   // Least recently used evictable entry
+    uint32_t lru_tail;   // Most recently used evictable entry
+    size_t total_cost;
+    size_t lru_cost;     // Cost of unreferenced entries (what eviction can free)
+    size_t budget;       // 0 = unlimited
 };
 
 // ============================================================================
 // Hash function (FNV-1a)
 // ============================================================================
 
-static uint64_t hash_string(const char* str) {
+static inline uint64_t hash_string(const char* str) {
     uint64_t hash = 14695981039346656037ULL;
     while (*str) {
         hash ^= (uint8_t)*str++;
@@ -45,11 +101,331 @@ static uint64_t hash_string(const char* str) {
     return hash;
 }
 
+static inline uint8_t hash_h2(uint64_t hash) {
+    return (uint8_t)(hash & 0x7F);
+}
+
+// ============================================================================
+// Group matching
+// ============================================================================
+
+// Bit i set if ctrl[i] == byte
+static inline uint32_t group_match(const uint8_t* ctrl, uint8_t byte) {
+#ifdef TC_MAP_SSE2
+    __m128i group = _mm_loadu_si128((const __m128i*)ctrl);
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char)byte)));
+#else
+    uint32_t mask = 0;
+    for (int i = 0; i < GROUP_SIZE; i++) {
+        if (ctrl[i] == byte) mask |= 1u << i;
+    }
+    return mask;
+#endif
+}
+
+// Bit i set if slot i is empty (only empty bytes have the high bit)
+static inline uint32_t group_match_empty(const uint8_t* ctrl) {
+#ifdef TC_MAP_SSE2
+    return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)ctrl));
+#else
+    uint32_t mask = 0;
+    for (int i = 0; i < GROUP_SIZE; i++) {
+        if (ctrl[i] & CTRL_EMPTY) mask |= 1u << i;
+    }
+    return mask;
+#endif
+}
+
+static inline int lowest_bit(uint32_t mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (int)index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
 // ============================================================================
 // Internal helpers
 // ============================================================================
 
-static void map_resize(tc_resource_map* map, size_t new_capacity);
+static inline size_t map_groups(const tc_resource_map* map) {
+    return map->capacity / GROUP_SIZE;
+}
+
+// First group of the probe sequence; step i adds i groups (triangular
+// probing visits every group when the group count is a power of two)
+static inline size_t probe_start(const tc_resource_map* map, uint64_t hash) {
+    return (size_t)(hash >> 7) & (map_groups(map) - 1);
+}
+
+static bool table_alloc(tc_resource_map* map, size_t capacity) {
+    size_t groups = capacity / GROUP_SIZE;
+    uint8_t* ctrl = (uint8_t*)malloc(capacity);
+    uint32_t* overflow = (uint32_t*)calloc(groups, sizeof(uint32_t));
+    uint32_t* slot_entry = (uint32_t*)malloc(capacity * sizeof(uint32_t));
+    if (!ctrl || !overflow || !slot_entry) {
+        free(ctrl);
+        free(overflow);
+        free(slot_entry);
+        return false;
+    }
+    memset(ctrl, CTRL_EMPTY, capacity);
+
+    map->ctrl = ctrl;
+    map->overflow = overflow;
+    map->slot_entry = slot_entry;
+    map->capacity = capacity;
+    return true;
+}
+
+// Slot holding uuid, or SIZE_MAX
+static size_t map_find(const tc_resource_map* map, const char* uuid, uint64_t hash) {
+    size_t gmask = map_groups(map) - 1;
+    size_t g = probe_start(map, hash);
+    uint8_t h2 = hash_h2(hash);
+
+    for (size_t step = 1; step <= map_groups(map); step++) {
+        size_t base = g * GROUP_SIZE;
+        for (uint32_t m = group_match(map->ctrl + base, h2); m; m &= m - 1) {
+            size_t slot = base + (size_t)lowest_bit(m);
+            const resource_entry* e = &map->entries[map->slot_entry[slot]];
+            if (e->hash == hash && strcmp(e->key, uuid) == 0) {
+                return slot;
+            }
+        }
+        if (map->overflow[g] == 0) return SIZE_MAX;
+        g = (g + step) & gmask;
+    }
+
+    return SIZE_MAX;
+}
+
+// Entry for uuid, or NULL
+static inline resource_entry* map_find_entry(const tc_resource_map* map, const char* uuid, uint64_t hash) {
+    size_t slot = map_find(map, uuid, hash);
+    return slot != SIZE_MAX ? &map->entries[map->slot_entry[slot]] : NULL;
+}
+
+// Place a key known to be absent; the table must have a free slot
+static size_t map_insert_slot(tc_resource_map* map, uint64_t hash) {
+    size_t gmask = map_groups(map) - 1;
+    size_t g = probe_start(map, hash);
+
+    for (size_t step = 1;; step++) {
+        uint32_t empty = group_match_empty(map->ctrl + g * GROUP_SIZE);
+        if (empty) {
+            size_t slot = g * GROUP_SIZE + (size_t)lowest_bit(empty);
+            map->ctrl[slot] = hash_h2(hash);
+            return slot;
+        }
+        map->overflow[g]++;
+        g = (g + step) & gmask;
+    }
+}
+
+// Probe for an add: the slot holding uuid, or SIZE_MAX. On a miss,
+// *insert_group is the first group on the probe sequence with an empty slot
+// and *insert_steps the groups probed before it (SIZE_MAX if none was seen)
+static size_t map_probe_add(const tc_resource_map* map, const char* uuid, uint64_t hash,
+                            size_t* insert_group, size_t* insert_steps) {
+    size_t gmask = map_groups(map) - 1;
+    size_t g = probe_start(map, hash);
+    uint8_t h2 = hash_h2(hash);
+    *insert_group = SIZE_MAX;
+
+    for (size_t step = 1; step <= map_groups(map); step++) {
+        size_t base = g * GROUP_SIZE;
+        for (uint32_t m = group_match(map->ctrl + base, h2); m; m &= m - 1) {
+            size_t slot = base + (size_t)lowest_bit(m);
+            const resource_entry* e = &map->entries[map->slot_entry[slot]];
+            if (e->hash == hash && strcmp(e->key, uuid) == 0) {
+                return slot;
+            }
+        }
+        if (*insert_group == SIZE_MAX && group_match_empty(map->ctrl + base)) {
+            *insert_group = g;
+            *insert_steps = step - 1;
+        }
+        if (map->overflow[g] == 0) return SIZE_MAX;
+        g = (g + step) & gmask;
+    }
+
+    return SIZE_MAX;
+}
+
+// Place a key in the group map_probe_add found, counting the overflow of
+// the groups before it
+static size_t map_insert_at(tc_resource_map* map, uint64_t hash, size_t group, size_t steps) {
+    size_t gmask = map_groups(map) - 1;
+    size_t g = probe_start(map, hash);
+    for (size_t step = 1; step <= steps; step++) {
+        map->overflow[g]++;
+        g = (g + step) & gmask;
+    }
+
+    size_t slot = group * GROUP_SIZE + (size_t)lowest_bit(group_match_empty(map->ctrl + group * GROUP_SIZE));
+    map->ctrl[slot] = hash_h2(hash);
+    return slot;
+}
+
+// Undo the overflow counts map_insert_slot added for the entry at slot
+static void map_release_slot(tc_resource_map* map, size_t slot, uint64_t hash) {
+    size_t gmask = map_groups(map) - 1;
+    size_t g = probe_start(map, hash);
+    size_t home = slot / GROUP_SIZE;
+
+    for (size_t step = 1; g != home; step++) {
+        map->overflow[g]--;
+        g = (g + step) & gmask;
+    }
+    map->ctrl[slot] = CTRL_EMPTY;
+}
+
+// Rebuild the slot arrays at new_capacity; entries stay where they are
+static bool table_resize(tc_resource_map* map, size_t new_capacity) {
+    uint8_t* old_ctrl = map->ctrl;
+    uint32_t* old_overflow = map->overflow;
+    uint32_t* old_slot_entry = map->slot_entry;
+
+    if (new_capacity > MAX_ENTRIES || !table_alloc(map, new_capacity)) return false;
+
+    for (size_t i = 0; i < map->entries_used; i++) {
+        resource_entry* e = &map->entries[i];
+        if (!e->key) continue;
+        size_t slot = map_insert_slot(map, e->hash);
+        map->slot_entry[slot] = (uint32_t)i;
+        e->slot = (uint32_t)slot;
+    }
+
+    free(old_ctrl);
+    free(old_overflow);
+    free(old_slot_entry);
+    return true;
+}
+
+// On the LRU list: unreferenced and evicting it frees something
+static inline bool lru_listed(const resource_entry* e) {
+    return e->refcount == 0 && e->cost > 0;
+}
+
+static void lru_unlink(tc_resource_map* map, uint32_t index) {
+    resource_entry* e = &map->entries[index];
+    if (e->lru_prev != LRU_NONE) map->entries[e->lru_prev].lru_next = e->lru_next;
+    else map->lru_head = e->lru_next;
+    if (e->lru_next != LRU_NONE) map->entries[e->lru_next].lru_prev = e->lru_prev;
+    else map->lru_tail = e->lru_prev;
+    map->lru_cost -= e->cost;
+}
+
+// Append as most recently used
+static void lru_push(tc_resource_map* map, uint32_t index) {
+    resource_entry* e = &map->entries[index];
+    e->lru_prev = map->lru_tail;
+    e->lru_next = LRU_NONE;
+    if (map->lru_tail != LRU_NONE) map->entries[map->lru_tail].lru_next = index;
+    else map->lru_head = index;
+    map->lru_tail = index;
+    map->lru_cost += e->cost;
+}
+
+static inline uint32_t lru_remap(const uint32_t* moved, uint32_t index) {
+    return index == LRU_NONE ? LRU_NONE : moved[index];
+}
+
+// Squeeze holes out of the entry array, keeping insertion order
+static bool entries_compact(tc_resource_map* map) {
+    uint32_t* moved = (uint32_t*)malloc(map->entries_used * sizeof(uint32_t));
+    if (!moved) return false;
+
+    size_t live = 0;
+    for (size_t i = 0; i < map->entries_used; i++) {
+        if (!map->entries[i].key) continue;
+        moved[i] = (uint32_t)live;
+        map->entries[live] = map->entries[i];
+        map->slot_entry[map->entries[live].slot] = (uint32_t)live;
+        live++;
+    }
+
+    for (size_t i = 0; i < live; i++) {
+        resource_entry* e = &map->entries[i];
+        if (!lru_listed(e)) continue;
+        e->lru_prev = lru_remap(moved, e->lru_prev);
+        e->lru_next = lru_remap(moved, e->lru_next);
+    }
+    map->lru_head = lru_remap(moved, map->lru_head);
+    map->lru_tail = lru_remap(moved, map->lru_tail);
+
+    free(moved);
+    map->entries_used = live;
+    map->holes = 0;
+    return true;
+}
+
+// Make room for extra more entries in both the table and the entry array
+static bool map_reserve_extra(tc_resource_map* map, size_t extra) {
+    size_t needed = map->count + extra;
+    if (needed > MAX_ENTRIES) return false;
+
+    // Table: keep load at or below 7/8
+    if (needed * MAX_LOAD_DEN > map->capacity * MAX_LOAD_NUM) {
+        size_t capacity = map->capacity;
+        while (needed * MAX_LOAD_DEN > capacity * MAX_LOAD_NUM) capacity *= 2;
+        if (!table_resize(map, capacity)) return false;
+    }
+
+    // Entries: reuse holes before growing
+    if (map->entries_used + extra <= map->entries_capacity) return true;
+    if (map->holes > 0 && map->holes * 2 >= map->entries_used && !entries_compact(map)) return false;
+    if (map->entries_used + extra <= map->entries_capacity) return true;
+
+    size_t entries_capacity = map->entries_capacity * 2;
+    if (entries_capacity < map->entries_used + extra) entries_capacity = map->entries_used + extra;
+    resource_entry* entries = (resource_entry*)realloc(map->entries, entries_capacity * sizeof(resource_entry));
+    if (!entries) return false;
+    map->entries = entries;
+    map->entries_capacity = entries_capacity;
+    return true;
+}
+
+// Remove the entry at index and free its key; returns the resource for the
+// caller to destroy
+static void* map_erase(tc_resource_map* map, uint32_t index) {
+    resource_entry* e = &map->entries[index];
+    void* value = e->value;
+
+    if (lru_listed(e)) lru_unlink(map, index);
+    map->total_cost -= e->cost;
+    map_release_slot(map, e->slot, e->hash);
+    free(e->key);
+    e->key = NULL;
+    map->count--;
+
+    // Trailing holes are dropped right away
+    if (index + 1 == map->entries_used) {
+        map->entries_used--;
+        while (map->entries_used > 0 && !map->entries[map->entries_used - 1].key) {
+            map->entries_used--;
+            map->holes--;
+        }
+    } else {
+        map->holes++;
+    }
+    return value;
+}
+
+// Evict least recently used unreferenced entries until within budget
+static void map_enforce_budget(tc_resource_map* map) {
+    if (map->budget == 0) return;
+
+    while (map->total_cost > map->budget && map->lru_cost > 0) {
+        void* value = map_erase(map, map->lru_head);
+        if (map->destructor && value) {
+            map->destructor(value);
+        }
+    }
+}
 
 // ============================================================================
 // Lifecycle
@@ -59,17 +435,15 @@ tc_resource_map* tc_resource_map_new(tc_resource_free_fn destructor) {
     tc_resource_map* map = (tc_resource_map*)calloc(1, sizeof(tc_resource_map));
     if (!map) return NULL;
 
-    size_t cap = 16;
-    map->entries = (resource_entry*)calloc(cap, sizeof(resource_entry));
-    if (!map->entries) {
+    if (!table_alloc(map, GROUP_SIZE)) {
         free(map);
         return NULL;
     }
 
-    map->capacity = cap;
     map->count = 0;
-    map->deleted = 0;
     map->destructor = destructor;
+    map->lru_head = LRU_NONE;
+    map->lru_tail = LRU_NONE;
 
     return map;
 }
@@ -78,17 +452,11 @@ void tc_resource_map_free(tc_resource_map* map) {
     if (!map) return;
 
     // Free all resources
-    if (map->entries) {
-        for (size_t i = 0; i < map->capacity; i++) {
-            if (map->entries[i].state == ENTRY_OCCUPIED) {
-                if (map->destructor && map->entries[i].value) {
-                    map->destructor(map->entries[i].value);
-                }
-                free(map->entries[i].key);
-            }
-        }
-        free(map->entries);
-    }
+    tc_resource_map_clear(map);
+    free(map->entries);
+    free(map->ctrl);
+    free(map->overflow);
+    free(map->slot_entry);
 
     free(map);
 }
@@ -96,168 +464,231 @@ void tc_resource_map_free(tc_resource_map* map) {
 void tc_resource_map_clear(tc_resource_map* map) {
     if (!map) return;
 
-    for (size_t i = 0; i < map->capacity; i++) {
-        if (map->entries[i].state == ENTRY_OCCUPIED) {
-            if (map->destructor && map->entries[i].value) {
-                map->destructor(map->entries[i].value);
-            }
-            free(map->entries[i].key);
-            map->entries[i].key = NULL;
-            map->entries[i].value = NULL;
-            map->entries[i].state = ENTRY_EMPTY;
-        } else if (map->entries[i].state == ENTRY_DELETED) {
-            map->entries[i].state = ENTRY_EMPTY;
+    for (size_t i = 0; i < map->entries_used; i++) {
+        resource_entry* e = &map->entries[i];
+        if (!e->key) continue;
+        if (map->destructor && e->value) {
+            map->destructor(e->value);
         }
+        free(e->key);
     }
+    memset(map->ctrl, CTRL_EMPTY, map->capacity);
+    memset(map->overflow, 0, map_groups(map) * sizeof(uint32_t));
 
+    map->entries_used = 0;
+    map->holes = 0;
     map->count = 0;
-    map->deleted = 0;
+    map->lru_head = LRU_NONE;
+    map->lru_tail = LRU_NONE;
+    map->total_cost = 0;
+    map->lru_cost = 0;
 }
 
 // ============================================================================
-// Resize
+// Operations
 // ============================================================================
 
-static void map_resize(tc_resource_map* map, size_t new_capacity) {
-    resource_entry* old_entries = map->entries;
-    size_t old_capacity = map->capacity;
+bool tc_resource_map_add(tc_resource_map* map, const char* uuid, void* resource) {
+    if (!uuid) return false;
+    return tc_resource_map_add_hashed(map, uuid, hash_string(uuid), resource);
+}
 
-    map->entries = (resource_entry*)calloc(new_capacity, sizeof(resource_entry));
-    if (!map->entries) {
-        map->entries = old_entries;
-        return;
-    }
+void* tc_resource_map_get(const tc_resource_map* map, const char* uuid) {
+    if (!uuid) return NULL;
+    return tc_resource_map_get_hashed(map, uuid, hash_string(uuid));
+}
 
-    map->capacity = new_capacity;
-    map->count = 0;
-    map->deleted = 0;
-
-    // Reinsert all entries
-    for (size_t i = 0; i < old_capacity; i++) {
-        if (old_entries[i].state == ENTRY_OCCUPIED) {
-            // Direct insert without destructor check
-            uint64_t hash = hash_string(old_entries[i].key);
-            size_t mask = map->capacity - 1;
-            size_t idx = hash & mask;
-
-            for (size_t j = 0; j < map->capacity; j++) {
-                size_t probe = (idx + j) & mask;
-                if (map->entries[probe].state == ENTRY_EMPTY) {
-                    map->entries[probe].key = old_entries[i].key;
-                    map->entries[probe].value = old_entries[i].value;
-                    map->entries[probe].state = ENTRY_OCCUPIED;
-                    map->count++;
-                    break;
-                }
-            }
+bool tc_resource_map_remove(tc_resource_map* map, const char* uuid) {
+    if (!uuid) return false;
+    return tc_resource_map_remove_hashed(map, uuid, hash_string(uuid));
+}
+
+bool tc_resource_map_contains(const tc_resource_map* map, const char* uuid) {
+    return tc_resource_map_get(map, uuid) != NULL;
+}
+
+bool tc_resource_map_replace(tc_resource_map* map, const char* uuid, void* resource) {
+    if (!map || !uuid) return false;
+
+    resource_entry* e = map_find_entry(map, uuid, hash_string(uuid));
+    if (!e) return false;
+    e->value = resource;
+    return true;
+}
+
+size_t tc_resource_map_count(const tc_resource_map* map) {
+    return map ? map->count : 0;
+}
+
+// ============================================================================
+// Bulk operations
+// ============================================================================
+
+bool tc_resource_map_reserve(tc_resource_map* map, size_t count) {
+    if (!map) return false;
+    return count <= map->count || map_reserve_extra(map, count - map->count);
+}
+
+size_t tc_resource_map_add_many(
+    tc_resource_map* map,
+    const char* const* uuids,
+    void* const* resources,
+    size_t n
+) {
+    if (!map || !uuids || n == 0) return 0;
+
+    // Rehash at most once up front
+    if (!map_reserve_extra(map, n)) return 0;
+
+    size_t added = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (!uuids[i]) continue;
+        void* resource = resources ? resources[i] : NULL;
+        if (tc_resource_map_add_hashed(map, uuids[i], hash_string(uuids[i]), resource)) {
+            added++;
         }
     }
-
-    free(old_entries);
+    return added;
 }
 
 // ============================================================================
-// Operations
+// Precomputed hashes
 // ============================================================================
 
-bool tc_resource_map_add(tc_resource_map* map, const char* uuid, void* resource) {
+uint64_t tc_resource_map_hash(const char* uuid) {
+    return uuid ? hash_string(uuid) : 0;
+}
+
+bool tc_resource_map_add_hashed(tc_resource_map* map, const char* uuid, uint64_t hash, void* resource) {
     if (!map || !uuid) return false;
 
-    // Check if already exists
-    if (tc_resource_map_contains(map, uuid)) {
+    // The duplicate check also finds where the key goes
+    size_t group, steps;
+    if (map_probe_add(map, uuid, hash, &group, &steps) != SIZE_MAX) {
         return false;
     }
+    size_t capacity = map->capacity;
+    if (!map_reserve_extra(map, 1)) return false;
+
+    char* key = tc_strdup(uuid);
+    if (!key) return false;
+
+    // A resize rebuilt the table, or the probe ended before an empty slot
+    uint32_t index = (uint32_t)map->entries_used++;
+    size_t slot = (group != SIZE_MAX && map->capacity == capacity)
+        ? map_insert_at(map, hash, group, steps)
+        : map_insert_slot(map, hash);
+    map->slot_entry[slot] = index;
+
+    resource_entry* e = &map->entries[index];
+    e->key = key;
+    e->value = resource;
+    e->hash = hash;
+    e->cost = 0;
+    e->slot = (uint32_t)slot;
+    e->refcount = 0;
+    map->count++;
+    return true;
+}
 
-    // Resize if load factor > 0.7
-    if ((map->count + map->deleted) * 10 > map->capacity * 7) {
-        map_resize(map, map->capacity * 2);
-    }
+void* tc_resource_map_get_hashed(const tc_resource_map* map, const char* uuid, uint64_t hash) {
+    if (!map || !uuid) return NULL;
 
-    uint64_t hash = hash_string(uuid);
-    size_t mask = map->capacity - 1;
-    size_t idx = hash & mask;
-    size_t first_deleted = SIZE_MAX;
+    resource_entry* e = map_find_entry(map, uuid, hash);
+    return e ? e->value : NULL;
+}
 
-    for (size_t i = 0; i < map->capacity; i++) {
-        size_t probe = (idx + i) & mask;
-        resource_entry* e = &map->entries[probe];
+bool tc_resource_map_remove_hashed(tc_resource_map* map, const char* uuid, uint64_t hash) {
+    if (!map || !uuid) return false;
 
-        if (e->state == ENTRY_EMPTY) {
-            if (first_deleted != SIZE_MAX) {
-                probe = first_deleted;
-                e = &map->entries[probe];
-                map->deleted--;
-            }
-            e->key = tc_strdup(uuid);
-            e->value = resource;
-            e->state = ENTRY_OCCUPIED;
-            map->count++;
-            return true;
-        } else if (e->state == ENTRY_DELETED) {
-            if (first_deleted == SIZE_MAX) first_deleted = probe;
-        }
+    size_t slot = map_find(map, uuid, hash);
+    if (slot == SIZE_MAX) return false;
+
+    void* value = map_erase(map, map->slot_entry[slot]);
+    if (map->destructor && value) {
+        map->destructor(value);
     }
+    return true;
+}
 
-    return false;
+bool tc_resource_map_contains_hashed(const tc_resource_map* map, const char* uuid, uint64_t hash) {
+    return tc_resource_map_get_hashed(map, uuid, hash) != NULL;
 }
 
-void* tc_resource_map_get(const tc_resource_map* map, const char* uuid) {
+// ============================================================================
+// Reference counting and budget
+// ============================================================================
+
+void* tc_resource_map_acquire(tc_resource_map* map, const char* uuid) {
     if (!map || !uuid) return NULL;
 
-    uint64_t hash = hash_string(uuid);
-    size_t mask = map->capacity - 1;
-    size_t idx = hash & mask;
+    size_t slot = map_find(map, uuid, hash_string(uuid));
+    if (slot == SIZE_MAX) return NULL;
 
-    for (size_t i = 0; i < map->capacity; i++) {
-        size_t probe = (idx + i) & mask;
-        const resource_entry* e = &map->entries[probe];
+    uint32_t index = map->slot_entry[slot];
+    resource_entry* e = &map->entries[index];
+    if (lru_listed(e)) lru_unlink(map, index);
+    e->refcount++;
+    return e->value;
+}
 
-        if (e->state == ENTRY_EMPTY) {
-            return NULL;
-        } else if (e->state == ENTRY_OCCUPIED && strcmp(e->key, uuid) == 0) {
-            return e->value;
-        }
-    }
+bool tc_resource_map_release(tc_resource_map* map, const char* uuid) {
+    if (!map || !uuid) return false;
+
+    size_t slot = map_find(map, uuid, hash_string(uuid));
+    if (slot == SIZE_MAX) return false;
 
-    return NULL;
+    uint32_t index = map->slot_entry[slot];
+    resource_entry* e = &map->entries[index];
+    if (e->refcount == 0) return false;
+
+    if (--e->refcount == 0 && e->cost > 0) {
+        lru_push(map, index);
+        map_enforce_budget(map);
+    }
+    return true;
 }
 
-bool tc_resource_map_remove(tc_resource_map* map, const char* uuid) {
-    if (!map || !uuid) return false;
+uint32_t tc_resource_map_refcount(const tc_resource_map* map, const char* uuid) {
+    if (!map || !uuid) return 0;
 
-    uint64_t hash = hash_string(uuid);
-    size_t mask = map->capacity - 1;
-    size_t idx = hash & mask;
+    resource_entry* e = map_find_entry(map, uuid, hash_string(uuid));
+    return e ? e->refcount : 0;
+}
 
-    for (size_t i = 0; i < map->capacity; i++) {
-        size_t probe = (idx + i) & mask;
-        resource_entry* e = &map->entries[probe];
+bool tc_resource_map_set_cost(tc_resource_map* map, const char* uuid, size_t cost) {
+    if (!map || !uuid) return false;
 
-        if (e->state == ENTRY_EMPTY) {
-            return false;
-        } else if (e->state == ENTRY_OCCUPIED && strcmp(e->key, uuid) == 0) {
-            if (map->destructor && e->value) {
-                map->destructor(e->value);
-            }
-            free(e->key);
-            e->key = NULL;
-            e->value = NULL;
-            e->state = ENTRY_DELETED;
-            map->count--;
-            map->deleted++;
-            return true;
+    resource_entry* e = map_find_entry(map, uuid, hash_string(uuid));
+    if (!e) return false;
+
+    uint32_t index = (uint32_t)(e - map->entries);
+    map->total_cost = map->total_cost - e->cost + cost;
+    if (e->refcount == 0) {
+        // Joins or leaves the LRU list when the cost crosses zero
+        if (e->cost > 0 && cost == 0) {
+            lru_unlink(map, index);
+        } else if (e->cost == 0 && cost > 0) {
+            e->cost = cost;
+            lru_push(map, index);
+        } else {
+            map->lru_cost = map->lru_cost - e->cost + cost;
         }
     }
-
-    return false;
+    e->cost = cost;
+    map_enforce_budget(map);
+    return true;
 }
 
-bool tc_resource_map_contains(const tc_resource_map* map, const char* uuid) {
-    return tc_resource_map_get(map, uuid) != NULL;
+void tc_resource_map_set_budget(tc_resource_map* map, size_t budget) {
+    if (!map) return;
+
+    map->budget = budget;
+    map_enforce_budget(map);
 }
 
-size_t tc_resource_map_count(const tc_resource_map* map) {
-    return map ? map->count : 0;
+size_t tc_resource_map_total_cost(const tc_resource_map* map) {
+    return map ? map->total_cost : 0;
 }
 
 // ============================================================================
@@ -271,11 +702,12 @@ void tc_resource_map_foreach(
 ) {
     if (!map || !callback) return;
 
-    for (size_t i = 0; i < map->capacity; i++) {
-        if (map->entries[i].state == ENTRY_OCCUPIED) {
-            if (!callback(map->entries[i].key, map->entries[i].value, user_data)) {
-                break;
-            }
+    // Bound re-read each step: the callback may remove entries
+    for (size_t i = 0; i < map->entries_used; i++) {
+        const resource_entry* e = &map->entries[i];
+        if (!e->key) continue;
+        if (!callback(e->key, e->value, user_data)) {
+            break;
         }
     }
 }
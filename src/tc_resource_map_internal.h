@@ -0,0 +1,9 @@
+// tc_resource_map_internal.h - tc_resource_map helpers for other library code
+#pragma once
+
+#include <tcbase/tc_resource_map.h>
+#include <stdbool.h>
+
+// Swap the resource stored under uuid in place; the old one is not
+// destroyed. Cannot fail for a present key. Returns false if uuid is absent.
+bool tc_resource_map_replace(tc_resource_map* map, const char* uuid, void* resource);
@@ -0,0 +1,289 @@
+// tc_resource_map_mt.cpp - Concurrent read-mostly resource map implementation
+#include <tcbase/tc_resource_map_mt.h>
+#include <tcbase/tc_log.h>
+#include "tc_epoch.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+// ============================================================================
+// Internal structures
+// ============================================================================
+
+namespace {
+
+// Immutable once published; the key bytes follow the struct
+struct mt_node {
+    uint64_t hash;
+    void* value;
+
+    const char* key() const { return reinterpret_cast<const char*>(this + 1); }
+};
+
+// Marks a removed entry; probes continue past it
+mt_node* const TOMBSTONE = reinterpret_cast<mt_node*>(uintptr_t(1));
+
+struct mt_table {
+    size_t capacity;              // Power of two
+    size_t used;                  // Live + tombstone slots (writer only)
+    std::atomic<mt_node*>* slots;
+};
+
+// Rebuild when live + tombstone slots would exceed 0.7 of capacity
+constexpr size_t MAX_LOAD_NUM = 7;
+constexpr size_t MAX_LOAD_DEN = 10;
+
+mt_node* node_create(const char* uuid, uint64_t hash, void* value) {
+    size_t len = strlen(uuid);
+    mt_node* node = static_cast<mt_node*>(malloc(sizeof(mt_node) + len + 1));
+    if (!node) return nullptr;
+    node->hash = hash;
+    node->value = value;
+    memcpy(node + 1, uuid, len + 1);
+    return node;
+}
+
+mt_table* table_create(size_t capacity) {
+    mt_table* table = new (std::nothrow) mt_table;
+    if (!table) return nullptr;
+    table->slots = new (std::nothrow) std::atomic<mt_node*>[capacity];
+    if (!table->slots) {
+        delete table;
+        return nullptr;
+    }
+    for (size_t i = 0; i < capacity; i++) {
+        table->slots[i].store(nullptr, std::memory_order_relaxed);
+    }
+    table->capacity = capacity;
+    table->used = 0;
+    return table;
+}
+
+void table_destroy(void* ptr) {
+    mt_table* table = static_cast<mt_table*>(ptr);
+    delete[] table->slots;
+    delete table;
+}
+
+inline bool is_live(const mt_node* node) {
+    return node && node != TOMBSTONE;
+}
+
+} // namespace
+
+struct tc_resource_map_mt {
+    std::atomic<mt_table*> table;
+    std::atomic<size_t> count;
+    tc_resource_free_fn destructor;
+    std::mutex write_mutex;            // Serializes writers
+    tc_epoch::RetireList retired;      // Guarded by write_mutex
+};
+
+// ============================================================================
+// Internal helpers
+// ============================================================================
+
+// Slot holding uuid, or SIZE_MAX; the node seen there goes to out_node.
+// Readers must hold an epoch guard.
+static size_t table_find(const mt_table* table, const char* uuid, uint64_t hash, mt_node** out_node) {
+    size_t mask = table->capacity - 1;
+    size_t idx = hash & mask;
+
+    for (size_t i = 0; i < table->capacity; i++) {
+        size_t probe = (idx + i) & mask;
+        mt_node* node = table->slots[probe].load(std::memory_order_acquire);
+
+        if (!node) {
+            return SIZE_MAX;
+        } else if (node != TOMBSTONE && node->hash == hash && strcmp(node->key(), uuid) == 0) {
+            *out_node = node;
+            return probe;
+        }
+    }
+
+    return SIZE_MAX;
+}
+
+// Writer only: place node in the first empty or tombstone slot
+static void table_insert(mt_table* table, mt_node* node) {
+    size_t mask = table->capacity - 1;
+    size_t probe = node->hash & mask;
+
+    for (;;) {
+        mt_node* cur = table->slots[probe].load(std::memory_order_relaxed);
+        if (!is_live(cur)) {
+            if (!cur) table->used++;
+            table->slots[probe].store(node, std::memory_order_release);
+            return;
+        }
+        probe = (probe + 1) & mask;
+    }
+}
+
+// Writer only: copy live nodes into a fresh table sized for count + 1 and
+// swap it in. Readers still walking the old table finish there.
+static bool map_rebuild(tc_resource_map_mt* map, mt_table* old) {
+    size_t live = map->count.load(std::memory_order_relaxed) + 1;
+    size_t capacity = 16;
+    while (capacity * MAX_LOAD_NUM < live * 2 * MAX_LOAD_DEN) capacity *= 2;
+
+    mt_table* table = table_create(capacity);
+    if (!table) return false;
+
+    for (size_t i = 0; i < old->capacity; i++) {
+        mt_node* node = old->slots[i].load(std::memory_order_relaxed);
+        if (is_live(node)) table_insert(table, node);
+    }
+
+    map->table.store(table, std::memory_order_release);
+    map->retired.retire(old, table_destroy);
+    return true;
+}
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+tc_resource_map_mt* tc_resource_map_mt_new(tc_resource_free_fn destructor) {
+    tc_resource_map_mt* map = new (std::nothrow) tc_resource_map_mt;
+    if (!map) return nullptr;
+
+    mt_table* table = table_create(16);
+    if (!table) {
+        delete map;
+        return nullptr;
+    }
+
+    map->table.store(table, std::memory_order_relaxed);
+    map->count.store(0, std::memory_order_relaxed);
+    map->destructor = destructor;
+    return map;
+}
+
+void tc_resource_map_mt_free(tc_resource_map_mt* map) {
+    if (!map) return;
+
+    mt_table* table = map->table.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < table->capacity; i++) {
+        mt_node* node = table->slots[i].load(std::memory_order_relaxed);
+        if (!is_live(node)) continue;
+        if (map->destructor && node->value) {
+            map->destructor(node->value);
+        }
+        free(node);
+    }
+    table_destroy(table);
+
+    map->retired.reclaim_all();
+    delete map;
+}
+
+// ============================================================================
+// Writers
+// ============================================================================
+
+bool tc_resource_map_mt_add(tc_resource_map_mt* map, const char* uuid, void* resource) {
+    if (!map || !uuid) return false;
+
+    uint64_t hash = tc_resource_map_hash(uuid);
+    std::lock_guard<std::mutex> lock(map->write_mutex);
+
+    mt_table* table = map->table.load(std::memory_order_relaxed);
+    mt_node* existing = nullptr;
+    if (table_find(table, uuid, hash, &existing) != SIZE_MAX) {
+        return false;
+    }
+
+    if ((table->used + 1) * MAX_LOAD_DEN > table->capacity * MAX_LOAD_NUM) {
+        if (!map_rebuild(map, table)) {
+            tc_log(TC_LOG_ERROR, "tc_resource_map_mt: failed to grow table");
+            return false;
+        }
+        table = map->table.load(std::memory_order_relaxed);
+    }
+
+    mt_node* node = node_create(uuid, hash, resource);
+    if (!node) return false;
+
+    table_insert(table, node);
+    map->count.fetch_add(1, std::memory_order_relaxed);
+    map->retired.reclaim();
+    return true;
+}
+
+bool tc_resource_map_mt_remove(tc_resource_map_mt* map, const char* uuid) {
+    if (!map || !uuid) return false;
+
+    uint64_t hash = tc_resource_map_hash(uuid);
+    void* value = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(map->write_mutex);
+
+        mt_table* table = map->table.load(std::memory_order_relaxed);
+        mt_node* node = nullptr;
+        size_t slot = table_find(table, uuid, hash, &node);
+        if (slot == SIZE_MAX) return false;
+
+        value = node->value;
+        table->slots[slot].store(TOMBSTONE, std::memory_order_release);
+        map->count.fetch_sub(1, std::memory_order_relaxed);
+
+        map->retired.retire(node, free);
+        map->retired.reclaim();
+    }
+
+    if (map->destructor && value) {
+        map->destructor(value);
+    }
+    return true;
+}
+
+// ============================================================================
+// Readers
+// ============================================================================
+
+void* tc_resource_map_mt_get(const tc_resource_map_mt* map, const char* uuid) {
+    if (!uuid) return nullptr;
+    return tc_resource_map_mt_get_hashed(map, uuid, tc_resource_map_hash(uuid));
+}
+
+void* tc_resource_map_mt_get_hashed(const tc_resource_map_mt* map, const char* uuid, uint64_t hash) {
+    if (!map || !uuid) return nullptr;
+
+    tc_epoch::Guard guard;
+    const mt_table* table = map->table.load(std::memory_order_acquire);
+    mt_node* node = nullptr;
+    if (table_find(table, uuid, hash, &node) == SIZE_MAX) return nullptr;
+
+    // Even if the entry was removed meanwhile, the node is still intact
+    return node->value;
+}
+
+bool tc_resource_map_mt_contains(const tc_resource_map_mt* map, const char* uuid) {
+    return tc_resource_map_mt_get(map, uuid) != nullptr;
+}
+
+size_t tc_resource_map_mt_count(const tc_resource_map_mt* map) {
+    return map ? map->count.load(std::memory_order_relaxed) : 0;
+}
+
+void tc_resource_map_mt_foreach(
+    const tc_resource_map_mt* map,
+    tc_resource_iter_fn callback,
+    void* user_data
+) {
+    if (!map || !callback) return;
+
+    tc_epoch::Guard guard;
+    const mt_table* table = map->table.load(std::memory_order_acquire);
+    for (size_t i = 0; i < table->capacity; i++) {
+        mt_node* node = table->slots[i].load(std::memory_order_acquire);
+        if (!is_live(node)) continue;
+        if (!callback(node->key(), node->value, user_data)) {
+            break;
+        }
+    }
+}
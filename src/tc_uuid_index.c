@@ -0,0 +1,358 @@
+// tc_uuid_index.c - Persistent memory-mapped UUID hash index
+#include <tcbase/tc_uuid_index.h>
+#include <tcbase/tc_log.h>
+#include "tc_file_map.h"
+#include "tc_resource_map_internal.h"
+#include "tc_uuid_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================================
+// File format
+// ============================================================================
+//
+// [header][slots]
+// Slots form a linear-probing table of capacity (a power of two) entries,
+// at most half full. An all-zero key marks an empty slot. Integers use the
+// writer's byte order.
+
+#define TC_UUID_INDEX_MAGIC "TCUI"
+#define TC_UUID_INDEX_VERSION 1
+#define TC_UUID_INDEX_BYTE_ORDER 0x01020304u
+#define TC_UUID_INDEX_SLOTS_OFFSET 64
+
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t reserved;
+    uint64_t count;
+    uint64_t capacity;
+    uint64_t slots_offset;
+    uint64_t total_size;
+} tc_uuid_index_header;
+
+typedef struct {
+    uint64_t hi;
+    uint64_t lo;
+    uint64_t value;
+} tc_uuid_index_slot;
+
+struct tc_uuid_index {
+    void* mapping;
+    size_t mapping_size;
+    const tc_uuid_index_slot* slots;
+    uint64_t capacity;
+    uint64_t count;
+};
+
+// ============================================================================
+// Writing
+// ============================================================================
+
+bool tc_uuid_index_write(const char* path, const tc_uuid* keys, const uint64_t* values, size_t n) {
+    if (!path || (n > 0 && (!keys || !values))) return false;
+
+    uint64_t capacity = 16;
+    while (capacity < (uint64_t)n * 2) capacity *= 2;
+
+    tc_uuid_index_slot* slots = (tc_uuid_index_slot*)calloc((size_t)capacity, sizeof(tc_uuid_index_slot));
+    if (!slots) {
+        tc_log(TC_LOG_ERROR, "tc_uuid_index: out of memory");
+        return false;
+    }
+
+    uint64_t count = 0;
+    uint64_t mask = capacity - 1;
+    for (size_t i = 0; i < n; i++) {
+        if (tc_uuid_is_nil(keys[i])) {
+            tc_log(TC_LOG_ERROR, "tc_uuid_index: nil UUID cannot be a key");
+            free(slots);
+            return false;
+        }
+        uint64_t probe = tc_uuid_hash(keys[i]) & mask;
+        while (slots[probe].hi || slots[probe].lo) {
+            if (slots[probe].hi == keys[i].hi && slots[probe].lo == keys[i].lo) break;
+            probe = (probe + 1) & mask;
+        }
+        if (!slots[probe].hi && !slots[probe].lo) count++;
+        slots[probe].hi = keys[i].hi;
+        slots[probe].lo = keys[i].lo;
+        slots[probe].value = values[i];
+    }
+
+    tc_uuid_index_header hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.magic, TC_UUID_INDEX_MAGIC, 4);
+    hdr.version = TC_UUID_INDEX_VERSION;
+    hdr.byte_order = TC_UUID_INDEX_BYTE_ORDER;
+    hdr.count = count;
+    hdr.capacity = capacity;
+    hdr.slots_offset = TC_UUID_INDEX_SLOTS_OFFSET;
+    hdr.total_size = hdr.slots_offset + capacity * sizeof(tc_uuid_index_slot);
+
+    FILE* f = fopen(path, "wb");
+    if (!f) {
+        tc_log(TC_LOG_ERROR, "tc_uuid_index: cannot open '%s' for writing", path);
+        free(slots);
+        return false;
+    }
+
+    static const char zeros[TC_UUID_INDEX_SLOTS_OFFSET] = {0};
+    size_t pad = TC_UUID_INDEX_SLOTS_OFFSET - sizeof(hdr);
+    bool ok = fwrite(&hdr, sizeof(hdr), 1, f) == 1 &&
+              fwrite(zeros, 1, pad, f) == pad &&
+              fwrite(slots, sizeof(tc_uuid_index_slot), (size_t)capacity, f) == (size_t)capacity;
+    ok = (fclose(f) == 0) && ok;
+    free(slots);
+
+    if (!ok) {
+        tc_log(TC_LOG_ERROR, "tc_uuid_index: failed to write '%s'", path);
+        remove(path);
+    }
+    return ok;
+}
+
+// ============================================================================
+// Reading
+// ============================================================================
+
+tc_uuid_index* tc_uuid_index_open(const char* path) {
+    if (!path) return NULL;
+
+    size_t size = 0;
+    void* base = tc_file_map_readonly(path, &size);
+    if (!base) return NULL;
+
+    const tc_uuid_index_header* hdr = (const tc_uuid_index_header*)base;
+    bool valid = size >= sizeof(*hdr) &&
+                 memcmp(hdr->magic, TC_UUID_INDEX_MAGIC, 4) == 0 &&
+                 hdr->version == TC_UUID_INDEX_VERSION &&
+                 hdr->byte_order == TC_UUID_INDEX_BYTE_ORDER;
+    valid = valid &&
+            hdr->capacity >= 16 && (hdr->capacity & (hdr->capacity - 1)) == 0 &&
+            hdr->count * 2 <= hdr->capacity &&
+            hdr->slots_offset == TC_UUID_INDEX_SLOTS_OFFSET &&
+            hdr->total_size == hdr->slots_offset + hdr->capacity * sizeof(tc_uuid_index_slot) &&
+            hdr->total_size <= size;
+    if (!valid) {
+        tc_log(TC_LOG_ERROR, "tc_uuid_index: '%s' is not a valid index", path);
+        tc_file_unmap(base, size);
+        return NULL;
+    }
+
+    tc_uuid_index* index = (tc_uuid_index*)malloc(sizeof(tc_uuid_index));
+    if (!index) {
+        tc_file_unmap(base, size);
+        return NULL;
+    }
+    index->mapping = base;
+    index->mapping_size = size;
+    index->slots = (const tc_uuid_index_slot*)((const char*)base + hdr->slots_offset);
+    index->capacity = hdr->capacity;
+    index->count = hdr->count;
+    return index;
+}
+
+void tc_uuid_index_close(tc_uuid_index* index) {
+    if (!index) return;
+    tc_file_unmap(index->mapping, index->mapping_size);
+    free(index);
+}
+
+bool tc_uuid_index_lookup(const tc_uuid_index* index, tc_uuid uuid, uint64_t* out_value) {
+    if (!index || tc_uuid_is_nil(uuid)) return false;
+
+    uint64_t mask = index->capacity - 1;
+    uint64_t probe = tc_uuid_hash(uuid) & mask;
+    for (uint64_t i = 0; i < index->capacity; i++) {
+        const tc_uuid_index_slot* s = &index->slots[probe];
+        if (s->hi == uuid.hi && s->lo == uuid.lo) {
+            if (out_value) *out_value = s->value;
+            return true;
+        }
+        if (!s->hi && !s->lo) return false;
+        probe = (probe + 1) & mask;
+    }
+    return false;
+}
+
+size_t tc_uuid_index_count(const tc_uuid_index* index) {
+    return index ? (size_t)index->count : 0;
+}
+
+// ============================================================================
+// Layered map
+// ============================================================================
+
+// Overlay value marking a base entry as removed
+static char g_whiteout;
+#define WHITEOUT ((void*)&g_whiteout)
+
+struct tc_layered_map {
+    const tc_uuid_index* base;
+    tc_resource_map* overlay;       // No destructor: resources are freed here
+    tc_resource_free_fn destructor;
+    tc_layered_load_fn load;
+    void* user_data;
+    size_t added;                   // Overlay keys absent from the base
+    size_t hidden;                  // Whiteouts
+};
+
+static bool base_lookup(const tc_layered_map* map, tc_uuid id, uint64_t* out_value) {
+    return map->base && tc_uuid_index_lookup(map->base, id, out_value);
+}
+
+// Overlay keys are the formatted UUID, so every spelling tc_uuid_parse
+// accepts (either letter case, with or without hyphens) shares one overlay
+// entry and whiteout
+static bool canonical_key(const char* uuid, tc_uuid* id, char key[TC_UUID_STRING_SIZE]) {
+    if (!uuid || !tc_uuid_parse(uuid, id)) return false;
+    tc_uuid_format(*id, key);
+    return true;
+}
+
+tc_layered_map* tc_layered_map_new(
+    const tc_uuid_index* base,
+    tc_resource_free_fn destructor,
+    tc_layered_load_fn load,
+    void* user_data
+) {
+    tc_layered_map* map = (tc_layered_map*)calloc(1, sizeof(tc_layered_map));
+    if (!map) return NULL;
+
+    map->overlay = tc_resource_map_new(NULL);
+    if (!map->overlay) {
+        free(map);
+        return NULL;
+    }
+    map->base = base;
+    map->destructor = destructor;
+    map->load = load;
+    map->user_data = user_data;
+    return map;
+}
+
+static bool destroy_overlay_entry(const char* uuid, void* resource, void* user_data) {
+    (void)uuid;
+    tc_layered_map* map = (tc_layered_map*)user_data;
+    if (resource != WHITEOUT && map->destructor) {
+        map->destructor(resource);
+    }
+    return true;
+}
+
+void tc_layered_map_free(tc_layered_map* map) {
+    if (!map) return;
+
+    tc_resource_map_foreach(map->overlay, destroy_overlay_entry, map);
+    tc_resource_map_free(map->overlay);
+    free(map);
+}
+
+bool tc_layered_map_add(tc_layered_map* map, const char* uuid, void* resource) {
+    tc_uuid id;
+    char key[TC_UUID_STRING_SIZE];
+    if (!map || !resource || !canonical_key(uuid, &id, key)) return false;
+
+    void* current = tc_resource_map_get(map->overlay, key);
+    if (current == WHITEOUT) {
+        // Re-adding a removed base key replaces the whiteout
+        tc_resource_map_remove(map->overlay, key);
+        if (!tc_resource_map_add(map->overlay, key, resource)) return false;
+        map->hidden--;
+        return true;
+    }
+    if (current || base_lookup(map, id, NULL)) return false;
+
+    if (!tc_resource_map_add(map->overlay, key, resource)) return false;
+    map->added++;
+    return true;
+}
+
+void* tc_layered_map_get(tc_layered_map* map, const char* uuid) {
+    tc_uuid id;
+    char key[TC_UUID_STRING_SIZE];
+    if (!map || !canonical_key(uuid, &id, key)) return NULL;
+
+    void* resource = tc_resource_map_get(map->overlay, key);
+    if (resource) return resource == WHITEOUT ? NULL : resource;
+
+    uint64_t value;
+    if (!map->load || !base_lookup(map, id, &value)) return NULL;
+
+    resource = map->load(key, value, map->user_data);
+    if (resource && !tc_resource_map_add(map->overlay, key, resource)) {
+        if (map->destructor) map->destructor(resource);
+        return NULL;
+    }
+    return resource;
+}
+
+bool tc_layered_map_remove(tc_layered_map* map, const char* uuid) {
+    tc_uuid id;
+    char key[TC_UUID_STRING_SIZE];
+    if (!map || !canonical_key(uuid, &id, key)) return false;
+
+    void* resource = tc_resource_map_get(map->overlay, key);
+    if (resource == WHITEOUT) return false;
+
+    bool in_base = base_lookup(map, id, NULL);
+    if (!resource && !in_base) return false;
+
+    // Record the whiteout before destroying anything, so a failure leaves
+    // the map unchanged. Over a loaded entry it replaces the resource.
+    if (in_base) {
+        bool recorded = resource
+            ? tc_resource_map_replace(map->overlay, key, WHITEOUT)
+            : tc_resource_map_add(map->overlay, key, WHITEOUT);
+        if (!recorded) {
+            tc_log(TC_LOG_ERROR, "tc_layered_map: failed to record removal of '%s'", key);
+            return false;
+        }
+        map->hidden++;
+    } else {
+        tc_resource_map_remove(map->overlay, key);
+        map->added--;
+    }
+    if (resource && map->destructor) map->destructor(resource);
+    return true;
+}
+
+bool tc_layered_map_contains(const tc_layered_map* map, const char* uuid) {
+    tc_uuid id;
+    char key[TC_UUID_STRING_SIZE];
+    if (!map || !canonical_key(uuid, &id, key)) return false;
+
+    void* resource = tc_resource_map_get(map->overlay, key);
+    if (resource) return resource != WHITEOUT;
+    return base_lookup(map, id, NULL);
+}
+
+size_t tc_layered_map_count(const tc_layered_map* map) {
+    if (!map) return 0;
+    return tc_uuid_index_count(map->base) - map->hidden + map->added;
+}
+
+typedef struct {
+    tc_resource_iter_fn callback;
+    void* user_data;
+} loaded_iter_ctx;
+
+static bool visit_loaded(const char* uuid, void* resource, void* user_data) {
+    loaded_iter_ctx* ctx = (loaded_iter_ctx*)user_data;
+    if (resource == WHITEOUT) return true;
+    return ctx->callback(uuid, resource, ctx->user_data);
+}
+
+void tc_layered_map_foreach_loaded(
+    tc_layered_map* map,
+    tc_resource_iter_fn callback,
+    void* user_data
+) {
+    if (!map || !callback) return;
+
+    loaded_iter_ctx ctx = {callback, user_data};
+    tc_resource_map_foreach(map->overlay, visit_loaded, &ctx);
+}
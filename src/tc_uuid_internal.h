@@ -0,0 +1,12 @@
+// tc_uuid_internal.h - UUID hash shared by tc_uuid_map and tc_uuid_index
+#pragma once
+
+#include <tcbase/tc_uuid_map.h>
+#include <stdint.h>
+
+// Random UUIDs are already well mixed; the multiply covers sequential ones.
+// Part of the tc_uuid_index file format: changing it invalidates existing files.
+static inline uint64_t tc_uuid_hash(tc_uuid id) {
+    uint64_t h = id.hi ^ (id.lo * 0x9E3779B97F4A7C15ULL);
+    return h ^ (h >> 32);
+}
@@ -0,0 +1,263 @@
+// tc_uuid_map.c - Resource map keyed by binary 128-bit UUIDs
+#include <tcbase/tc_uuid_map.h>
+#include "tc_uuid_internal.h"
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================================
+// UUID text form
+// ============================================================================
+
+static int hex_value(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+bool tc_uuid_parse(const char* str, tc_uuid* out) {
+    if (!str || !out) return false;
+
+    size_t len = strlen(str);
+    bool hyphens = len == 36;
+    if (!hyphens && len != 32) return false;
+
+    uint64_t words[2] = {0, 0};
+    int digits = 0;
+    for (size_t i = 0; i < len; i++) {
+        if (hyphens && (i == 8 || i == 13 || i == 18 || i == 23)) {
+            if (str[i] != '-') return false;
+            continue;
+        }
+        int v = hex_value(str[i]);
+        if (v < 0) return false;
+        words[digits / 16] = (words[digits / 16] << 4) | (uint64_t)v;
+        digits++;
+    }
+
+    out->hi = words[0];
+    out->lo = words[1];
+    return true;
+}
+
+void tc_uuid_format(tc_uuid id, char out[TC_UUID_STRING_SIZE]) {
+    static const char digits[] = "0123456789abcdef";
+    int pos = 0;
+    for (int n = 0; n < 32; n++) {
+        if (n == 8 || n == 12 || n == 16 || n == 20) out[pos++] = '-';
+        uint64_t word = n < 16 ? id.hi : id.lo;
+        out[pos++] = digits[(word >> (60 - 4 * (n % 16))) & 0xF];
+    }
+    out[pos] = '\0';
+}
+
+// ============================================================================
+// Internal structures
+// ============================================================================
+
+#define ENTRY_EMPTY   0
+#define ENTRY_OCCUPIED 1
+#define ENTRY_DELETED  2
+
+// 24 bytes; slot states live in a separate byte array
+typedef struct {
+    tc_uuid key;
+    void* value;
+} uuid_entry;
+
+struct tc_uuid_map {
+    uuid_entry* entries;
+    uint8_t* states;
+    size_t capacity;
+    size_t count;
+    size_t deleted;
+    tc_resource_free_fn destructor;
+};
+
+// ============================================================================
+// Internal helpers
+// ============================================================================
+
+static bool map_alloc(tc_uuid_map* map, size_t capacity) {
+    uuid_entry* entries = (uuid_entry*)malloc(capacity * sizeof(uuid_entry));
+    uint8_t* states = (uint8_t*)calloc(capacity, 1);
+    if (!entries || !states) {
+        free(entries);
+        free(states);
+        return false;
+    }
+    map->entries = entries;
+    map->states = states;
+    map->capacity = capacity;
+    return true;
+}
+
+// Slot holding uuid, or SIZE_MAX
+static size_t map_find(const tc_uuid_map* map, tc_uuid uuid) {
+    size_t mask = map->capacity - 1;
+    size_t idx = tc_uuid_hash(uuid) & mask;
+
+    for (size_t i = 0; i < map->capacity; i++) {
+        size_t probe = (idx + i) & mask;
+        if (map->states[probe] == ENTRY_EMPTY) {
+            return SIZE_MAX;
+        } else if (map->states[probe] == ENTRY_OCCUPIED && tc_uuid_eq(map->entries[probe].key, uuid)) {
+            return probe;
+        }
+    }
+
+    return SIZE_MAX;
+}
+
+static void map_resize(tc_uuid_map* map, size_t new_capacity) {
+    uuid_entry* old_entries = map->entries;
+    uint8_t* old_states = map->states;
+    size_t old_capacity = map->capacity;
+
+    if (!map_alloc(map, new_capacity)) return;
+    map->deleted = 0;
+
+    // Reinsert all entries; keys are known to be unique
+    size_t mask = new_capacity - 1;
+    for (size_t i = 0; i < old_capacity; i++) {
+        if (old_states[i] != ENTRY_OCCUPIED) continue;
+        size_t probe = tc_uuid_hash(old_entries[i].key) & mask;
+        while (map->states[probe] != ENTRY_EMPTY) {
+            probe = (probe + 1) & mask;
+        }
+        map->entries[probe] = old_entries[i];
+        map->states[probe] = ENTRY_OCCUPIED;
+    }
+
+    free(old_entries);
+    free(old_states);
+}
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+tc_uuid_map* tc_uuid_map_new(tc_resource_free_fn destructor) {
+    tc_uuid_map* map = (tc_uuid_map*)calloc(1, sizeof(tc_uuid_map));
+    if (!map) return NULL;
+
+    if (!map_alloc(map, 16)) {
+        free(map);
+        return NULL;
+    }
+    map->destructor = destructor;
+    return map;
+}
+
+void tc_uuid_map_free(tc_uuid_map* map) {
+    if (!map) return;
+
+    tc_uuid_map_clear(map);
+    free(map->entries);
+    free(map->states);
+    free(map);
+}
+
+void tc_uuid_map_clear(tc_uuid_map* map) {
+    if (!map) return;
+
+    for (size_t i = 0; i < map->capacity; i++) {
+        if (map->states[i] == ENTRY_OCCUPIED && map->destructor && map->entries[i].value) {
+            map->destructor(map->entries[i].value);
+        }
+    }
+    memset(map->states, ENTRY_EMPTY, map->capacity);
+
+    map->count = 0;
+    map->deleted = 0;
+}
+
+// ============================================================================
+// Operations
+// ============================================================================
+
+bool tc_uuid_map_add(tc_uuid_map* map, tc_uuid uuid, void* resource) {
+    if (!map) return false;
+
+    // Rehash once live + deleted slots pass 0.7. When tombstones are the
+    // larger part, clearing them at the same capacity is enough; growing
+    // there would double the table under add/remove churn.
+    if ((map->count + map->deleted) * 10 > map->capacity * 7) {
+        bool mostly_deleted = map->deleted >= map->count;
+        map_resize(map, mostly_deleted ? map->capacity : map->capacity * 2);
+    }
+
+    size_t mask = map->capacity - 1;
+    size_t idx = tc_uuid_hash(uuid) & mask;
+    size_t first_deleted = SIZE_MAX;
+
+    for (size_t i = 0; i < map->capacity; i++) {
+        size_t probe = (idx + i) & mask;
+        uint8_t state = map->states[probe];
+
+        if (state == ENTRY_EMPTY) {
+            if (first_deleted != SIZE_MAX) {
+                probe = first_deleted;
+                map->deleted--;
+            }
+            map->entries[probe].key = uuid;
+            map->entries[probe].value = resource;
+            map->states[probe] = ENTRY_OCCUPIED;
+            map->count++;
+            return true;
+        } else if (state == ENTRY_DELETED) {
+            if (first_deleted == SIZE_MAX) first_deleted = probe;
+        } else if (tc_uuid_eq(map->entries[probe].key, uuid)) {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+void* tc_uuid_map_get(const tc_uuid_map* map, tc_uuid uuid) {
+    if (!map) return NULL;
+
+    size_t slot = map_find(map, uuid);
+    return slot != SIZE_MAX ? map->entries[slot].value : NULL;
+}
+
+bool tc_uuid_map_remove(tc_uuid_map* map, tc_uuid uuid) {
+    if (!map) return false;
+
+    size_t slot = map_find(map, uuid);
+    if (slot == SIZE_MAX) return false;
+
+    if (map->destructor && map->entries[slot].value) {
+        map->destructor(map->entries[slot].value);
+    }
+    map->entries[slot].value = NULL;
+    map->states[slot] = ENTRY_DELETED;
+    map->count--;
+    map->deleted++;
+    return true;
+}
+
+bool tc_uuid_map_contains(const tc_uuid_map* map, tc_uuid uuid) {
+    return map && map_find(map, uuid) != SIZE_MAX;
+}
+
+size_t tc_uuid_map_count(const tc_uuid_map* map) {
+    return map ? map->count : 0;
+}
+
+// ============================================================================
+// Iteration
+// ============================================================================
+
+void tc_uuid_map_foreach(tc_uuid_map* map, tc_uuid_iter_fn callback, void* user_data) {
+    if (!map || !callback) return;
+
+    for (size_t i = 0; i < map->capacity; i++) {
+        if (map->states[i] == ENTRY_OCCUPIED) {
+            if (!callback(map->entries[i].key, map->entries[i].value, user_data)) {
+                break;
+            }
+        }
+    }
+}
@@ -0,0 +1,339 @@
+// tgfx_intern_string.cpp - Shared string interning implementation
+#include <tcbase/tgfx_intern_string.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+// ============================================================================
+// Internal structures
+// ============================================================================
+
+namespace {
+
+// Interned strings live in arena blocks: [hash][len][atom][bytes...\0]
+struct InternEntry {
+    uint32_t hash;
+    uint32_t len;
+    uint32_t atom;
+
+    char* str() { return reinterpret_cast<char*>(this + 1); }
+};
+
+struct ArenaBlock {
+    ArenaBlock* next;
+    size_t used;
+    size_t size;
+
+    char* data() { return reinterpret_cast<char*>(this + 1); }
+};
+
+constexpr size_t ARENA_BLOCK_SIZE = 64 * 1024;
+
+// The hash sits next to the pointer so mismatches never touch string bytes.
+// Writers store hash, then publish entry with release.
+struct InternSlot {
+    std::atomic<uint32_t> hash;
+    std::atomic<InternEntry*> entry;
+};
+
+struct InternTable {
+    InternTable* retired_next;     // Older tables, freed at cleanup
+    size_t capacity;               // Power of two
+    InternSlot* slots;
+};
+
+constexpr size_t INITIAL_CAPACITY = 1024;
+
+// Atom -> entry. Chunk k holds ATOM_CHUNK0 << k entries, so chunks never
+// move and readers index them without a lock.
+constexpr uint32_t ATOM_CHUNK0_BITS = 10;
+constexpr uint32_t ATOM_CHUNK0 = 1u << ATOM_CHUNK0_BITS;
+constexpr uint32_t ATOM_CHUNK_COUNT = 33 - ATOM_CHUNK0_BITS;
+
+std::atomic<std::atomic<InternEntry*>*> g_atom_chunks[ATOM_CHUNK_COUNT];
+
+// Grow when more than 3/4 full
+constexpr size_t MAX_LOAD_NUM = 3;
+constexpr size_t MAX_LOAD_DEN = 4;
+
+std::atomic<InternTable*> g_table{nullptr};
+std::mutex g_write_mutex;
+
+// Guarded by g_write_mutex
+size_t g_count = 0;
+ArenaBlock* g_arena = nullptr;
+InternTable* g_retired = nullptr;
+
+inline uint32_t bit_width(uint32_t v) {
+    uint32_t width = 0;
+    while (v) {
+        v >>= 1;
+        width++;
+    }
+    return width;
+}
+
+// Chunk and offset of atom (atoms start at 1)
+inline void atom_position(uint32_t atom, uint32_t* chunk, uint32_t* offset) {
+    uint64_t v = uint64_t(atom) - 1 + ATOM_CHUNK0;
+    uint32_t k = bit_width(uint32_t(v >> ATOM_CHUNK0_BITS)) - 1;
+    *chunk = k;
+    *offset = uint32_t(v - (uint64_t(ATOM_CHUNK0) << k));
+}
+
+// Writer only: record entry under the next atom id
+bool atom_assign(InternEntry* entry) {
+    if (g_count >= UINT32_MAX - 1) return false;
+    uint32_t atom = uint32_t(g_count) + 1;
+    uint32_t chunk, offset;
+    atom_position(atom, &chunk, &offset);
+
+    std::atomic<InternEntry*>* slots = g_atom_chunks[chunk].load(std::memory_order_relaxed);
+    if (!slots) {
+        size_t size = size_t(ATOM_CHUNK0) << chunk;
+        slots = new (std::nothrow) std::atomic<InternEntry*>[size];
+        if (!slots) return false;
+        for (size_t i = 0; i < size; i++) {
+            slots[i].store(nullptr, std::memory_order_relaxed);
+        }
+        g_atom_chunks[chunk].store(slots, std::memory_order_release);
+    }
+    entry->atom = atom;
+    slots[offset].store(entry, std::memory_order_release);
+    return true;
+}
+
+InternEntry* atom_entry(tgfx_atom atom) {
+    if (atom == TGFX_ATOM_NONE) return nullptr;
+    uint32_t chunk, offset;
+    atom_position(atom, &chunk, &offset);
+    std::atomic<InternEntry*>* slots = g_atom_chunks[chunk].load(std::memory_order_acquire);
+    return slots ? slots[offset].load(std::memory_order_acquire) : nullptr;
+}
+
+InternTable* table_create(size_t capacity) {
+    InternTable* table = new (std::nothrow) InternTable;
+    if (!table) return nullptr;
+    table->slots = new (std::nothrow) InternSlot[capacity];
+    if (!table->slots) {
+        delete table;
+        return nullptr;
+    }
+    for (size_t i = 0; i < capacity; i++) {
+        table->slots[i].hash.store(0, std::memory_order_relaxed);
+        table->slots[i].entry.store(nullptr, std::memory_order_relaxed);
+    }
+    table->capacity = capacity;
+    table->retired_next = nullptr;
+    return table;
+}
+
+void table_destroy(InternTable* table) {
+    delete[] table->slots;
+    delete table;
+}
+
+// Lock-free probe; safe against a concurrent writer on the same table
+InternEntry* table_find(const InternTable* table, const char* s, size_t len, uint32_t hash) {
+    size_t mask = table->capacity - 1;
+    size_t probe = hash & mask;
+
+    for (size_t i = 0; i < table->capacity; i++) {
+        const InternSlot& slot = table->slots[probe];
+        InternEntry* entry = slot.entry.load(std::memory_order_acquire);
+        if (!entry) return nullptr;
+        if (slot.hash.load(std::memory_order_relaxed) == hash &&
+            entry->len == len && memcmp(entry->str(), s, len) == 0) {
+            return entry;
+        }
+        probe = (probe + 1) & mask;
+    }
+    return nullptr;
+}
+
+// Writer only
+void table_insert(InternTable* table, InternEntry* entry) {
+    size_t mask = table->capacity - 1;
+    size_t probe = entry->hash & mask;
+
+    while (table->slots[probe].entry.load(std::memory_order_relaxed)) {
+        probe = (probe + 1) & mask;
+    }
+    table->slots[probe].hash.store(entry->hash, std::memory_order_relaxed);
+    table->slots[probe].entry.store(entry, std::memory_order_release);
+}
+
+// Writer only: copy into a table twice as large and publish it. Readers
+// still probing the old table finish there; it stays allocated until
+// cleanup, since entries are never removed.
+InternTable* table_grow(InternTable* old) {
+    InternTable* table = table_create(old->capacity * 2);
+    if (!table) return nullptr;
+
+    for (size_t i = 0; i < old->capacity; i++) {
+        InternEntry* entry = old->slots[i].entry.load(std::memory_order_relaxed);
+        if (entry) table_insert(table, entry);
+    }
+    g_table.store(table, std::memory_order_release);
+
+    old->retired_next = g_retired;
+    g_retired = old;
+    return table;
+}
+
+// Writer only: bump-allocate an entry with room for len bytes + NUL
+InternEntry* arena_alloc_entry(size_t len) {
+    constexpr size_t align = alignof(InternEntry);
+    size_t need = (sizeof(InternEntry) + len + 1 + align - 1) & ~(align - 1);
+
+    if (!g_arena || g_arena->size - g_arena->used < need) {
+        size_t size = need > ARENA_BLOCK_SIZE ? need : ARENA_BLOCK_SIZE;
+        ArenaBlock* block = static_cast<ArenaBlock*>(malloc(sizeof(ArenaBlock) + size));
+        if (!block) return nullptr;
+        block->used = 0;
+        block->size = size;
+        // Keep a partly used block current if the new one is a dedicated oversize block
+        if (g_arena && size > ARENA_BLOCK_SIZE) {
+            block->next = g_arena->next;
+            g_arena->next = block;
+            block->used = need;
+            return reinterpret_cast<InternEntry*>(block->data());
+        }
+        block->next = g_arena;
+        g_arena = block;
+    }
+
+    InternEntry* entry = reinterpret_cast<InternEntry*>(g_arena->data() + g_arena->used);
+    g_arena->used += need;
+    return entry;
+}
+
+InternEntry* intern_locked(const char* s, size_t len, uint32_t hash) {
+    std::lock_guard<std::mutex> lock(g_write_mutex);
+
+    InternTable* table = g_table.load(std::memory_order_relaxed);
+    if (!table) {
+        table = table_create(INITIAL_CAPACITY);
+        if (!table) return nullptr;
+        g_table.store(table, std::memory_order_release);
+    } else if (InternEntry* found = table_find(table, s, len, hash)) {
+        return found;
+    }
+
+    if ((g_count + 1) * MAX_LOAD_DEN > table->capacity * MAX_LOAD_NUM) {
+        table = table_grow(table);
+        if (!table) return nullptr;
+    }
+
+    InternEntry* entry = arena_alloc_entry(len);
+    if (!entry) return nullptr;
+    entry->hash = hash;
+    entry->len = static_cast<uint32_t>(len);
+    memcpy(entry->str(), s, len);
+    entry->str()[len] = '\0';
+    if (!atom_assign(entry)) return nullptr;
+
+    table_insert(table, entry);
+    g_count++;
+    return entry;
+}
+
+InternEntry* intern_entry(const char* s, size_t len, uint32_t hash) {
+    if (!s || len > UINT32_MAX) return nullptr;
+
+    InternTable* table = g_table.load(std::memory_order_acquire);
+    if (table) {
+        if (InternEntry* found = table_find(table, s, len, hash)) {
+            return found;
+        }
+    }
+    return intern_locked(s, len, hash);
+}
+
+} // namespace
+
+// ============================================================================
+// Strings
+// ============================================================================
+
+uint32_t tgfx_intern_hash(const char* s, size_t len) {
+    uint32_t hash = TGFX_INTERN_HASH_SEED;
+    for (size_t i = 0; i < len; i++) {
+        hash = tgfx_intern_hash_step(hash, static_cast<unsigned char>(s[i]));
+    }
+    return hash;
+}
+
+const char* tgfx_intern_string(const char* s) {
+    if (!s) return nullptr;
+    return tgfx_intern_string_n(s, strlen(s));
+}
+
+const char* tgfx_intern_string_n(const char* s, size_t len) {
+    InternEntry* entry = intern_entry(s, len, tgfx_intern_hash(s, len));
+    return entry ? entry->str() : nullptr;
+}
+
+// ============================================================================
+// Atoms
+// ============================================================================
+
+tgfx_atom tgfx_atom_intern(const char* s) {
+    if (!s) return TGFX_ATOM_NONE;
+    return tgfx_atom_intern_n(s, strlen(s));
+}
+
+tgfx_atom tgfx_atom_intern_n(const char* s, size_t len) {
+    return tgfx_atom_intern_hashed(s, len, tgfx_intern_hash(s, len));
+}
+
+tgfx_atom tgfx_atom_intern_hashed(const char* s, size_t len, uint32_t hash) {
+    InternEntry* entry = intern_entry(s, len, hash);
+    return entry ? entry->atom : TGFX_ATOM_NONE;
+}
+
+tgfx_atom tgfx_atom_of_interned(const char* interned) {
+    if (!interned) return TGFX_ATOM_NONE;
+    const InternEntry* entry = reinterpret_cast<const InternEntry*>(interned) - 1;
+    return entry->atom;
+}
+
+const char* tgfx_atom_string(tgfx_atom atom) {
+    InternEntry* entry = atom_entry(atom);
+    return entry ? entry->str() : nullptr;
+}
+
+size_t tgfx_atom_length(tgfx_atom atom) {
+    InternEntry* entry = atom_entry(atom);
+    return entry ? entry->len : 0;
+}
+
+tgfx_atom tgfx_atom_count(void) {
+    std::lock_guard<std::mutex> lock(g_write_mutex);
+    return tgfx_atom(g_count);
+}
+
+void tgfx_intern_cleanup(void) {
+    std::lock_guard<std::mutex> lock(g_write_mutex);
+
+    InternTable* table = g_table.exchange(nullptr, std::memory_order_acq_rel);
+    if (table) table_destroy(table);
+    while (g_retired) {
+        InternTable* next = g_retired->retired_next;
+        table_destroy(g_retired);
+        g_retired = next;
+    }
+    while (g_arena) {
+        ArenaBlock* next = g_arena->next;
+        free(g_arena);
+        g_arena = next;
+    }
+    for (uint32_t k = 0; k < ATOM_CHUNK_COUNT; k++) {
+        delete[] g_atom_chunks[k].exchange(nullptr, std::memory_order_acq_rel);
+    }
+    g_count = 0;
+}
@@ -0,0 +1,368 @@
+// Tests for tc_log: async ring delivery, overflow policies, flushing,
+// deferred binary records and sinks
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <tcbase/tc_log.hpp>
+#include <tcbase/tc_log_sink.h>
+
+#define TEST_ASSERT(cond, msg) \
+    do { \
+        if (!(cond)) { \
+            printf("FAIL: %s (line %d)\n", msg, __LINE__); \
+            return 1; \
+        } \
+    } while (0)
+
+static std::atomic<int> g_received{0};
+static std::atomic<int> g_errors{0};
+static std::atomic<bool> g_bad_text{false};
+static std::thread::id g_callback_thread;
+
+// The callback can be held to back up the ring
+static std::mutex g_gate_mutex;
+static std::condition_variable g_gate_cv;
+static bool g_gate_open = true;
+
+static void set_gate(bool open) {
+    {
+        std::lock_guard<std::mutex> lock(g_gate_mutex);
+        g_gate_open = open;
+    }
+    g_gate_cv.notify_all();
+}
+
+static void count_callback(tc_log_level level, const char* message) {
+    {
+        std::unique_lock<std::mutex> lock(g_gate_mutex);
+        g_gate_cv.wait(lock, []() { return g_gate_open; });
+    }
+    if (strncmp(message, "msg ", 4) != 0 && strncmp(message, "tc_log:", 7) != 0 &&
+        strncmp(message, "fatal", 5) != 0) {
+        g_bad_text = true;
+    }
+    if (level == TC_LOG_ERROR) g_errors++;
+    g_callback_thread = std::this_thread::get_id();
+    g_received++;
+}
+
+static int test_async_delivery() {
+    g_received = 0;
+    g_bad_text = false;
+    tc_log_set_callback(count_callback);
+    TEST_ASSERT(tc_log_start_async(8192, TC_LOG_OVERFLOW_BLOCK), "start");
+
+    constexpr int THREADS = 4;
+    constexpr int MESSAGES = 100;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; t++) {
+        threads.emplace_back([t]() {
+            for (int i = 0; i < MESSAGES; i++) {
+                tc_log(TC_LOG_DEBUG, "msg %d from thread %d", i, t);
+            }
+        });
+    }
+    for (std::thread& t : threads) {
+        t.join();
+    }
+
+    tc_log_flush();
+    TEST_ASSERT(g_received == THREADS * MESSAGES, "every message delivered with blocking policy");
+    TEST_ASSERT(!g_bad_text, "message text intact");
+    TEST_ASSERT(g_callback_thread != std::this_thread::get_id(), "callback on writer thread");
+
+    tc_log_stop_async();
+    tc_log_set_callback(nullptr);
+    return 0;
+}
+
+static int test_async_drop_and_error_flush() {
+    g_received = 0;
+    g_errors = 0;
+    tc_log_set_callback(count_callback);
+    TEST_ASSERT(tc_log_start_async(4096, TC_LOG_OVERFLOW_COUNT), "start");
+
+    // Hold the writer so the ring fills up
+    set_gate(false);
+    uint64_t dropped_before = tc_log_dropped();
+    int sent = 0;
+    while (tc_log_dropped() == dropped_before && sent < 100000) {
+        tc_log(TC_LOG_INFO, "msg %d padding padding padding padding", sent++);
+    }
+    TEST_ASSERT(tc_log_dropped() > dropped_before, "full ring drops");
+    uint64_t dropped = tc_log_dropped() - dropped_before;
+    set_gate(true);
+
+    // An error is written out before tc_log returns
+    tc_log(TC_LOG_ERROR, "fatal %d", 1);
+    TEST_ASSERT(g_errors == 1, "error flushed synchronously");
+
+    tc_log_stop_async();
+    // Delivered + dropped covers everything; the drop notice adds one more
+    TEST_ASSERT((uint64_t)g_received == (uint64_t)sent - dropped + 1 + 1, "drop accounting");
+
+    // Back to synchronous logging
+    int before = g_received;
+    tc_log(TC_LOG_INFO, "msg sync");
+    TEST_ASSERT(g_received == before + 1, "sync after stop");
+
+    tc_log_set_callback(nullptr);
+    return 0;
+}
+
+static std::mutex g_lines_mutex;
+static std::vector<std::string> g_lines;
+
+static void capture_callback(tc_log_level level, const char* message) {
+    (void)level;
+    std::lock_guard<std::mutex> lock(g_lines_mutex);
+    g_lines.push_back(message);
+}
+
+enum class Phase : uint8_t { Load = 3 };
+
+static int test_deferred_records() {
+    g_lines.clear();
+    tc_log_set_callback(capture_callback);
+
+    std::string name = "crate";
+    const char* missing = nullptr;
+    tc::Log::Deferred::info("load %s (%d/%u) %.2f %s", name, -3, 7u, 0.5, std::string_view("ok"));
+    tc::Log::Deferred::info("%5ld|%-4lld|%zu|%c|%x|%s", 42L, -1LL, size_t(9), 'q', 255, missing);
+    tc::Log::Deferred::debug("%*d|%.*s|%d|%d%%", 4, 7, 2, "abcdef", Phase::Load, true);
+    tc::Log::Deferred::warn("%d %s", 1);
+    {
+        std::lock_guard<std::mutex> lock(g_lines_mutex);
+        TEST_ASSERT(g_lines.empty(), "records are not formatted on the logging thread");
+    }
+
+    tc_log_flush();
+    {
+        std::lock_guard<std::mutex> lock(g_lines_mutex);
+        TEST_ASSERT(g_lines.size() == 4, "all records drained");
+        TEST_ASSERT(g_lines[0] == "load crate (-3/7) 0.50 ok", "strings and numbers");
+        TEST_ASSERT(g_lines[1] == "   42|-1  |9|q|ff|(null)", "length modifiers and null string");
+        TEST_ASSERT(g_lines[2] == "   7|ab|3|1%", "star width, enum, bool");
+        TEST_ASSERT(g_lines[3] == "1 <?>", "missing argument");
+    }
+
+    // Per-thread order survives the merge; every record arrives once
+    g_lines.clear();
+    constexpr int THREADS = 3;
+    constexpr int MESSAGES = 2000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; t++) {
+        threads.emplace_back([t]() {
+            for (int i = 0; i < MESSAGES; i++) {
+                tc::Log::Deferred::info("t%d %d", t, i);
+            }
+        });
+    }
+    for (std::thread& t : threads) {
+        t.join();
+    }
+    tc_log_flush();
+    {
+        std::lock_guard<std::mutex> lock(g_lines_mutex);
+        TEST_ASSERT(g_lines.size() == THREADS * MESSAGES, "records from exited threads drained");
+        int next[THREADS] = {0, 0, 0};
+        for (const std::string& line : g_lines) {
+            int t = -1, i = -1;
+            sscanf(line.c_str(), "t%d %d", &t, &i);
+            TEST_ASSERT(t >= 0 && t < THREADS && i == next[t], "per-thread order");
+            next[t]++;
+        }
+    }
+
+    // With the async writer running, it drains the records itself
+    g_lines.clear();
+    TEST_ASSERT(tc_log_start_async(8192, TC_LOG_OVERFLOW_BLOCK), "start async");
+    tc::Log::Deferred::info("async %d", 1);
+    tc::Log::Deferred::error("async %s", "error");
+    {
+        std::lock_guard<std::mutex> lock(g_lines_mutex);
+        TEST_ASSERT(g_lines.size() == 2 && g_lines[1] == "async error", "error record flushed");
+    }
+    tc_log_stop_async();
+
+    // Deferred and plain messages from one thread keep their order
+    for (int async = 0; async < 2; async++) {
+        g_lines.clear();
+        if (async) TEST_ASSERT(tc_log_start_async(8192, TC_LOG_OVERFLOW_BLOCK), "start async");
+        for (int i = 0; i < 300; i++) {
+            if (i % 3 == 0) tc_log_info("m %d", i);
+            else tc::Log::Deferred::info("m %d", i);
+        }
+        tc_log_flush();
+        if (async) tc_log_stop_async();
+
+        std::lock_guard<std::mutex> lock(g_lines_mutex);
+        TEST_ASSERT(g_lines.size() == 300, "mixed messages delivered");
+        for (int i = 0; i < 300; i++) {
+            TEST_ASSERT(g_lines[i] == "m " + std::to_string(i), "mixed messages in order");
+        }
+    }
+
+    tc_log_set_callback(nullptr);
+    return 0;
+}
+
+static int g_evaluated = 0;
+
+static int side_effect() {
+    g_evaluated++;
+    return 1;
+}
+
+static int test_level_filters() {
+    g_received = 0;
+    g_evaluated = 0;
+    tc_log_set_callback(count_callback);
+
+    tc_log_set_level(TC_LOG_INFO);
+    TEST_ASSERT(!tc::Log::enabled(TC_LOG_DEBUG) && tc::Log::enabled(TC_LOG_WARN), "runtime level");
+    TC_DEBUG("msg %d", side_effect());
+    TEST_ASSERT(g_evaluated == 0 && g_received == 0, "filtered arguments not evaluated");
+    TC_INFO("msg %d", side_effect());
+    TEST_ASSERT(g_evaluated == 1 && g_received == 1, "enabled level logs");
+    tc_log_set_level(TC_LOG_DEBUG);
+
+    // Build-time stripping, as if compiled with -DTC_LOG_COMPILED_LEVEL=2
+#undef TC_LOG_COMPILED_LEVEL
+#define TC_LOG_COMPILED_LEVEL 2
+    TC_INFO("msg %d", side_effect());
+    TEST_ASSERT(g_evaluated == 1 && g_received == 1, "stripped below compiled level");
+    TC_WARN("msg %d", side_effect());
+    TEST_ASSERT(g_evaluated == 2 && g_received == 2, "kept at compiled level");
+#undef TC_LOG_COMPILED_LEVEL
+#define TC_LOG_COMPILED_LEVEL 0
+
+    tc_log_set_callback(nullptr);
+    return 0;
+}
+
+static size_t g_sink_len = 0;
+
+static void len_sink(void* user_data, tc_log_level level, const char* message, size_t len) {
+    (void)level;
+    *static_cast<int*>(user_data) += 1;
+    g_sink_len = strlen(message) == len ? len : SIZE_MAX;
+}
+
+static std::string read_file(const std::string& path) {
+    std::string text;
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) return text;
+    char buf[256];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) text.append(buf, n);
+    fclose(f);
+    return text;
+}
+
+static int test_sinks() {
+    // Memory sink with its own level
+    tc_log_sink_id mem = tc_log_add_memory_sink(64, TC_LOG_WARN);
+    TEST_ASSERT(mem != TC_LOG_SINK_INVALID, "memory sink");
+    TEST_ASSERT(tc_log_remove_sink(TC_LOG_STDERR_SINK), "remove stderr sink");
+    tc_log_info("hidden");
+    tc_log_warn("first %d", 1);
+    tc_log_error("second");
+    char out[64];
+    size_t len = tc_log_memory_sink_read(mem, out, sizeof(out));
+    TEST_ASSERT(std::string(out) == "[WARN] first 1\n[ERROR] second\n", "sink level filter");
+    TEST_ASSERT(len == strlen(out), "full length");
+
+    for (int i = 0; i < 10; i++) tc_log_warn("line %d", i);
+    len = tc_log_memory_sink_read(mem, out, 8);
+    TEST_ASSERT(len <= 64 && strlen(out) == 7, "capacity bound and truncated copy");
+    TEST_ASSERT(tc_log_remove_sink(mem) && !tc_log_remove_sink(mem), "remove once");
+
+    // Callback sink gets the length
+    int calls = 0;
+    tc_log_sink_id cb = tc_log_add_callback_sink(len_sink, &calls, TC_LOG_DEBUG);
+    tc_log_debug("abc %s", "def");
+    TEST_ASSERT(calls == 1 && g_sink_len == 7, "callback sink length");
+    TEST_ASSERT(tc_log_sink_set_level(cb, TC_LOG_ERROR), "set sink level");
+    tc_log_warn("filtered");
+    TEST_ASSERT(calls == 1, "per-sink level");
+    tc_log_remove_sink(cb);
+
+    // File sink rotation by size
+    std::string path = "termin_base_log_test.log";
+    tc_log_file_options options = {};
+    options.max_bytes = 64;
+    options.max_files = 2;
+    options.buffer_bytes = 32;
+    tc_log_sink_id file = tc_log_add_file_sink(path.c_str(), &options, TC_LOG_DEBUG);
+    TEST_ASSERT(file != TC_LOG_SINK_INVALID, "file sink");
+    for (int i = 0; i < 12; i++) tc_log_info("entry %02d", i);
+    tc_log_flush();
+    std::string current = read_file(path);
+    std::string rotated = read_file(path + ".1");
+    TEST_ASSERT(current.size() <= 64 && rotated.size() <= 64, "files stay under max_bytes");
+    TEST_ASSERT(current.find("[INFO] entry 11\n") != std::string::npos, "latest in current file");
+    TEST_ASSERT(!rotated.empty() && !read_file(path + ".2").empty(), "rotated files kept");
+    TEST_ASSERT(read_file(path + ".3").empty(), "older files removed");
+
+    // Batched in async mode, flushed by tc_log_flush
+    TEST_ASSERT(tc_log_start_async(8192, TC_LOG_OVERFLOW_BLOCK), "start");
+    tc_log_info("async entry");
+    tc_log_flush();
+    tc_log_stop_async();
+    TEST_ASSERT(read_file(path).find("[INFO] async entry\n") != std::string::npos, "async file write");
+
+    tc_log_remove_sink(file);
+    remove(path.c_str());
+    remove((path + ".1").c_str());
+    remove((path + ".2").c_str());
+
+    // A failed reopen does not rotate again on every line
+    namespace fs = std::filesystem;
+    fs::path dir = "termin_base_log_test_dir";
+    fs::path moved = "termin_base_log_test_moved";
+    fs::remove_all(dir);
+    fs::remove_all(moved);
+    fs::create_directory(dir);
+    file = tc_log_add_file_sink((dir / "log").string().c_str(), &options, TC_LOG_DEBUG);
+    TEST_ASSERT(file != TC_LOG_SINK_INVALID, "file sink in directory");
+    fs::rename(dir, moved);
+    for (int i = 0; i < 5; i++) tc_log_info("entry %02d", i);
+    fs::create_directory(dir);
+    FILE* kept = fopen((dir / "log.1").string().c_str(), "wb");
+    TEST_ASSERT(kept && fputs("keep\n", kept) >= 0 && fclose(kept) == 0, "write kept file");
+    tc_log_info("after");
+    tc_log_flush();
+    TEST_ASSERT(read_file((dir / "log.1").string()) == "keep\n", "kept files survive a failed reopen");
+    tc_log_remove_sink(file);
+    fs::remove_all(dir);
+    fs::remove_all(moved);
+
+    TEST_ASSERT(tc_log_add_stderr_sink(TC_LOG_DEBUG) != TC_LOG_SINK_INVALID, "stderr sink back");
+    return 0;
+}
+
+int main() {
+    printf("=== tc_log tests ===\n");
+
+    int result = 0;
+    result |= test_async_delivery();
+    result |= test_async_drop_and_error_flush();
+    result |= test_deferred_records();
+    result |= test_level_filters();
+    result |= test_sinks();
+
+    if (result == 0) {
+        printf("PASS\n");
+    } else {
+        printf("FAIL\n");
+    }
+    return result;
+}
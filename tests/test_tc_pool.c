@@ -0,0 +1,524 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <tcbase/tc_pool.h>
+
+#define TEST_ASSERT(cond, msg) \
+    do { \
+        if (!(cond)) { \
+            printf("FAIL: %s (line %d)\n", msg, __LINE__); \
+            return 1; \
+        } \
+    } while (0)
+
+typedef struct {
+    int value;
+    double weight;
+} PoolItem;
+
+static bool sum_values(uint32_t index, void* item, void* user_data) {
+    (void)index;
+    *(int*)user_data += ((PoolItem*)item)->value;
+    return true;
+}
+
+typedef struct {
+    tc_pool* pool;
+    int visited;
+} FreeNextCtx;
+
+// Frees the following slot, which must then not be visited
+static bool free_next(uint32_t index, void* item, void* user_data) {
+    (void)item;
+    FreeNextCtx* ctx = (FreeNextCtx*)user_data;
+    ctx->visited++;
+    tc_handle next = {index + 1, ctx->pool->generations[index + 1]};
+    tc_pool_free_slot(ctx->pool, next);
+    return true;
+}
+
+static int test_pool_bitmap_iteration(void) {
+    tc_pool pool;
+    TEST_ASSERT(tc_pool_init(&pool, sizeof(PoolItem), 0), "init");
+
+    tc_handle handles[300];
+    tc_pool_alloc_n(&pool, 300, handles);
+    TEST_ASSERT(pool.occupied[0] == UINT64_MAX, "full word");
+
+    FreeNextCtx ctx = {&pool, 0};
+    tc_pool_foreach(&pool, free_next, &ctx);
+    TEST_ASSERT(ctx.visited == 150, "slots freed by callback are skipped");
+    TEST_ASSERT(tc_pool_count(&pool) == 150, "count after freeing in foreach");
+
+    tc_pool_clear(&pool);
+    for (uint32_t w = 0; w < TC_POOL_WORD_COUNT(pool.capacity); w++) {
+        TEST_ASSERT(pool.occupied[w] == 0, "clear empties bitmap");
+    }
+    TEST_ASSERT(!tc_pool_is_valid(&pool, handles[1]), "clear bumps generations");
+
+    tc_pool_free(&pool);
+    return 0;
+}
+
+static int test_pool_basic(void) {
+    tc_pool pool;
+    TEST_ASSERT(tc_pool_init(&pool, sizeof(PoolItem), 4), "init");
+
+    tc_handle handles[40];
+    for (int i = 0; i < 40; i++) {
+        handles[i] = tc_pool_alloc(&pool);
+        TEST_ASSERT(!tc_handle_is_invalid(handles[i]), "alloc");
+        ((PoolItem*)tc_pool_get(&pool, handles[i]))->value = i;
+    }
+    TEST_ASSERT(tc_pool_count(&pool) == 40, "count after alloc");
+
+    TEST_ASSERT(tc_pool_free_slot(&pool, handles[3]), "free slot");
+    TEST_ASSERT(!tc_pool_is_valid(&pool, handles[3]), "stale handle rejected");
+    TEST_ASSERT(!tc_pool_free_slot(&pool, handles[3]), "double free rejected");
+
+    tc_handle reused = tc_pool_alloc(&pool);
+    TEST_ASSERT(reused.index == handles[3].index, "slot reused");
+    TEST_ASSERT(reused.generation != handles[3].generation, "generation bumped");
+    TEST_ASSERT(((PoolItem*)tc_pool_get(&pool, reused))->value == 0, "reused slot zeroed");
+
+    tc_pool_clear(&pool);
+    TEST_ASSERT(tc_pool_count(&pool) == 0, "count after clear");
+    TEST_ASSERT(!tc_pool_is_valid(&pool, reused), "clear invalidates handles");
+
+    tc_pool_free(&pool);
+    return 0;
+}
+
+static int test_pool_dense(void) {
+    tc_pool pool;
+    tc_pool_desc desc;
+    memset(&desc, 0, sizeof(desc));
+    desc.item_size = sizeof(PoolItem);
+    desc.flags = TC_POOL_DENSE;
+    TEST_ASSERT(tc_pool_init_ex(&pool, &desc), "dense init");
+
+    tc_handle handles[100];
+    for (int i = 0; i < 100; i++) {
+        handles[i] = tc_pool_alloc(&pool);
+        ((PoolItem*)tc_pool_get(&pool, handles[i]))->value = i;
+    }
+
+    // Free every other item; survivors must stay packed and reachable
+    for (int i = 0; i < 100; i += 2) {
+        TEST_ASSERT(tc_pool_free_slot(&pool, handles[i]), "dense free");
+    }
+    TEST_ASSERT(tc_pool_count(&pool) == 50, "dense count");
+
+    int expected = 0;
+    for (int i = 1; i < 100; i += 2) {
+        PoolItem* item = (PoolItem*)tc_pool_get(&pool, handles[i]);
+        TEST_ASSERT(item && item->value == i, "dense lookup after swap-remove");
+        expected += i;
+        TEST_ASSERT(!tc_pool_is_valid(&pool, handles[i - 1]), "dense stale handle");
+    }
+
+    PoolItem* items = (PoolItem*)tc_pool_dense_items(&pool);
+    int packed_sum = 0;
+    for (uint32_t d = 0; d < tc_pool_count(&pool); d++) {
+        TEST_ASSERT(tc_pool_get_unchecked(&pool, tc_pool_dense_slot(&pool, d)) == &items[d],
+                    "dense mapping consistent");
+        packed_sum += items[d].value;
+    }
+    TEST_ASSERT(packed_sum == expected, "packed array holds live items");
+
+    int foreach_sum = 0;
+    tc_pool_foreach(&pool, sum_values, &foreach_sum);
+    TEST_ASSERT(foreach_sum == expected, "dense foreach");
+
+    tc_pool_free(&pool);
+    return 0;
+}
+
+static int test_pool_paged(void) {
+    tc_pool pool;
+    tc_pool_desc desc;
+    memset(&desc, 0, sizeof(desc));
+    desc.item_size = sizeof(PoolItem);
+    desc.flags = TC_POOL_PAGED;
+    desc.page_items = 10;  // rounded up to 16
+    TEST_ASSERT(tc_pool_init_ex(&pool, &desc), "paged init");
+    TEST_ASSERT(pool.page_shift == 4, "page size rounded to power of two");
+
+    tc_handle handles[64];
+    PoolItem* ptrs[64];
+    for (int i = 0; i < 64; i++) {
+        handles[i] = tc_pool_alloc(&pool);
+        ptrs[i] = (PoolItem*)tc_pool_get(&pool, handles[i]);
+        ptrs[i]->value = i;
+    }
+    TEST_ASSERT(pool.page_count == 4, "growth adds pages");
+
+    // Pointers taken before growth are still the live addresses
+    for (int i = 0; i < 64; i++) {
+        TEST_ASSERT(tc_pool_get(&pool, handles[i]) == ptrs[i], "stable item address");
+        TEST_ASSERT(ptrs[i]->value == i, "item data preserved");
+    }
+
+    // Emptying pages releases them (one is kept as spare)
+    for (int i = 0; i < 48; i++) {
+        tc_pool_free_slot(&pool, handles[i]);
+    }
+    TEST_ASSERT(pool.pages[0] == NULL && pool.pages[1] == NULL && pool.pages[2] == NULL,
+                "empty pages released");
+    TEST_ASSERT(pool.spare_page != NULL, "spare page kept");
+
+    int sum = 0;
+    tc_pool_foreach(&pool, sum_values, &sum);
+    int expected = 0;
+    for (int i = 48; i < 64; i++) expected += i;
+    TEST_ASSERT(sum == expected, "paged foreach");
+
+    tc_pool_trim(&pool);
+    TEST_ASSERT(pool.spare_page == NULL, "trim drops spare page");
+
+    tc_handle h = tc_pool_alloc(&pool);
+    TEST_ASSERT(tc_pool_get(&pool, h) != NULL, "alloc into released page");
+
+    tc_pool_free(&pool);
+    return 0;
+}
+
+static int test_pool_batch(void) {
+    tc_pool pool;
+    TEST_ASSERT(tc_pool_init(&pool, sizeof(PoolItem), 0), "init");
+
+    tc_handle handles[130];
+    TEST_ASSERT(tc_pool_alloc_n(&pool, 130, handles) == 130, "alloc_n");
+    TEST_ASSERT(tc_pool_count(&pool) == 130, "count after alloc_n");
+
+    // Free every third handle, then corrupt one generation
+    tc_handle doomed[44];
+    uint32_t doomed_count = 0;
+    for (uint32_t i = 0; i < 130; i += 3) doomed[doomed_count++] = handles[i];
+    TEST_ASSERT(tc_pool_free_n(&pool, doomed, doomed_count) == doomed_count, "free_n");
+    TEST_ASSERT(tc_pool_free_n(&pool, doomed, doomed_count) == 0, "free_n skips stale");
+    handles[1].generation += 7;
+    handles[2].index = 100000;
+
+    uint64_t mask[3] = {0, 0, 0};
+    void* items[130];
+    uint32_t valid = tc_pool_get_many(&pool, handles, 130, items, mask);
+    TEST_ASSERT(valid == 130 - doomed_count - 2, "get_many valid count");
+    TEST_ASSERT(tc_pool_validate_many(&pool, handles, 130, mask) == valid, "validate_many count");
+
+    for (uint32_t i = 0; i < 130; i++) {
+        bool bit = (mask[i / 64] >> (i % 64)) & 1;
+        TEST_ASSERT(bit == tc_pool_is_valid(&pool, handles[i]), "mask matches is_valid");
+        TEST_ASSERT(items[i] == tc_pool_get(&pool, handles[i]), "get_many matches get");
+    }
+
+    tc_pool_free(&pool);
+    return 0;
+}
+
+static void mark_chunk(tc_pool* pool, uint32_t begin, uint32_t end, void* user_data) {
+    int* visits = (int*)user_data;
+    if (tc_pool_dense_items(pool)) {
+        for (uint32_t d = begin; d < end; d++) {
+            visits[tc_pool_dense_slot(pool, d)]++;
+        }
+        return;
+    }
+    for (uint32_t i = begin; i < end; i++) {
+        if (tc_pool_slot_occupied(pool, i)) {
+            ((PoolItem*)tc_pool_get_unchecked(pool, i))->weight = 2.0;
+            visits[i]++;
+        }
+    }
+}
+
+static int test_pool_parallel_foreach(void) {
+    static int visits[4096];
+    uint32_t flags[2] = {0, TC_POOL_DENSE};
+
+    for (int mode = 0; mode < 2; mode++) {
+        tc_pool pool;
+        tc_pool_desc desc;
+        memset(&desc, 0, sizeof(desc));
+        desc.item_size = sizeof(PoolItem);
+        desc.flags = flags[mode];
+        TEST_ASSERT(tc_pool_init_ex(&pool, &desc), "init");
+
+        tc_handle handles[4000];
+        tc_pool_alloc_n(&pool, 4000, handles);
+        for (uint32_t i = 0; i < 4000; i += 5) tc_pool_free_slot(&pool, handles[i]);
+
+        memset(visits, 0, sizeof(visits));
+        tc_pool_parallel_foreach(&pool, mark_chunk, visits, 100, 4);
+
+        for (uint32_t i = 0; i < 4000; i++) {
+            int expected = (i % 5 == 0) ? 0 : 1;
+            TEST_ASSERT(visits[handles[i].index] == expected, "each live item visited once");
+        }
+        tc_pool_free(&pool);
+    }
+    return 0;
+}
+
+static int test_pool_compact(void) {
+    uint32_t flags[3] = {0, TC_POOL_DENSE, TC_POOL_PAGED};
+
+    for (int mode = 0; mode < 3; mode++) {
+        tc_pool pool;
+        tc_pool_desc desc;
+        memset(&desc, 0, sizeof(desc));
+        desc.item_size = sizeof(PoolItem);
+        desc.flags = flags[mode];
+        desc.page_items = 16;
+        TEST_ASSERT(tc_pool_init_ex(&pool, &desc), "init");
+
+        tc_handle handles[200];
+        tc_pool_alloc_n(&pool, 200, handles);
+        for (int i = 0; i < 200; i++) {
+            ((PoolItem*)tc_pool_get(&pool, handles[i]))->value = i;
+        }
+        // Keep every tenth item
+        for (int i = 0; i < 200; i++) {
+            if (i % 10 != 0) tc_pool_free_slot(&pool, handles[i]);
+        }
+
+        uint32_t old_capacity = pool.capacity;
+        tc_handle remap[256];
+        TEST_ASSERT(tc_pool_compact(&pool, remap), "compact");
+        TEST_ASSERT(pool.capacity < old_capacity, "capacity shrunk");
+
+        for (int i = 0; i < 200; i += 10) {
+            tc_handle moved = remap[handles[i].index];
+            PoolItem* item = (PoolItem*)tc_pool_get(&pool, moved);
+            TEST_ASSERT(item && item->value == i, "remapped handle resolves");
+            TEST_ASSERT(moved.index < tc_pool_count(&pool), "live items in prefix");
+            if (!tc_handle_eq(moved, handles[i])) {
+                TEST_ASSERT(!tc_pool_is_valid(&pool, handles[i]), "moved-from handle stale");
+            }
+        }
+
+        // Regrowing must not revive handles into truncated slots
+        tc_handle extra[200];
+        tc_pool_alloc_n(&pool, 200, extra);
+        for (int i = 0; i < 200; i++) {
+            if (i % 10 != 0) {
+                TEST_ASSERT(!tc_pool_is_valid(&pool, handles[i]), "stale handle rejected after regrow");
+            }
+        }
+        tc_pool_free(&pool);
+    }
+    return 0;
+}
+
+// Overwrite a uint32 in a pool image, at extra bytes into the section whose
+// offset is stored at header byte offset_field (see tc_pool_snapshot.c)
+static bool patch_image(const char* path, long offset_field, uint64_t extra, uint32_t value) {
+    FILE* f = fopen(path, "r+b");
+    if (!f) return false;
+    uint64_t section = 0;
+    bool ok = fseek(f, offset_field, SEEK_SET) == 0 && fread(&section, sizeof(section), 1, f) == 1 &&
+              fseek(f, (long)(section + extra), SEEK_SET) == 0 && fwrite(&value, sizeof(value), 1, f) == 1;
+    fclose(f);
+    return ok;
+}
+
+static int test_pool_snapshot(void) {
+    const char* path = "tc_pool_snapshot_test.bin";
+    uint32_t flags[3] = {0, TC_POOL_DENSE, TC_POOL_PAGED};
+
+    for (int mode = 0; mode < 3; mode++) {
+        tc_pool pool;
+        tc_pool_desc desc;
+        memset(&desc, 0, sizeof(desc));
+        desc.item_size = sizeof(PoolItem);
+        desc.flags = flags[mode];
+        desc.page_items = 16;
+        TEST_ASSERT(tc_pool_init_ex(&pool, &desc), "init");
+
+        tc_handle handles[100];
+        tc_pool_alloc_n(&pool, 100, handles);
+        for (int i = 0; i < 100; i++) {
+            ((PoolItem*)tc_pool_get(&pool, handles[i]))->value = i;
+        }
+        for (int i = 0; i < 100; i += 3) tc_pool_free_slot(&pool, handles[i]);
+        TEST_ASSERT(tc_pool_snapshot(&pool, path), "snapshot");
+
+        for (int restore = 0; restore < 2; restore++) {
+            tc_pool loaded;
+            uint32_t restore_flags = restore ? TC_POOL_RESTORE_MAP : TC_POOL_RESTORE_COPY;
+            TEST_ASSERT(tc_pool_restore(&loaded, path, restore_flags), "restore");
+            TEST_ASSERT(tc_pool_count(&loaded) == tc_pool_count(&pool), "restored count");
+
+            for (int i = 0; i < 100; i++) {
+                PoolItem* item = (PoolItem*)tc_pool_get(&loaded, handles[i]);
+                if (i % 3 == 0) {
+                    TEST_ASSERT(item == NULL, "freed handle stays stale");
+                } else {
+                    TEST_ASSERT(item && item->value == i, "handle valid across save/load");
+                }
+            }
+
+            if (restore) {
+                TEST_ASSERT(tc_handle_is_invalid(tc_pool_alloc(&loaded)), "mapped pool is read-only");
+            } else {
+                tc_handle h = tc_pool_alloc(&loaded);
+                TEST_ASSERT(tc_pool_get(&loaded, h) != NULL, "copied pool is mutable");
+            }
+            tc_pool_free(&loaded);
+        }
+
+        // Out-of-range indices in the image are rejected, not trusted
+        if (mode == 0) {
+            TEST_ASSERT(patch_image(path, 80, 0, 0xFFFFFFFFu), "patch free list");
+        } else if (mode == 1) {
+            uint64_t dense_to_slot = (uint64_t)pool.capacity * sizeof(uint32_t);
+            TEST_ASSERT(patch_image(path, 88, dense_to_slot, 0xFFFFFFFFu), "patch dense map");
+        }
+        if (mode < 2) {
+            tc_pool loaded;
+            TEST_ASSERT(!tc_pool_restore(&loaded, path, TC_POOL_RESTORE_COPY), "corrupt image copy");
+            TEST_ASSERT(!tc_pool_restore(&loaded, path, TC_POOL_RESTORE_MAP), "corrupt image map");
+        }
+        tc_pool_free(&pool);
+    }
+
+    remove(path);
+    return 0;
+}
+
+typedef struct {
+    int constructed;
+    int destroyed;
+    int relocated;
+    int batches;
+} HookStats;
+
+static void item_init(void* item, void* user_data) {
+    ((PoolItem*)item)->value = 7;
+    ((HookStats*)user_data)->constructed++;
+}
+
+static void item_destroy(void* item, void* user_data) {
+    ((PoolItem*)item)->value = -1;
+    ((HookStats*)user_data)->destroyed++;
+}
+
+static void item_relocate(void* dst, void* src, void* user_data) {
+    memcpy(dst, src, sizeof(PoolItem));
+    ((HookStats*)user_data)->relocated++;
+}
+
+static void items_init_batch(tc_pool* pool, const tc_handle* handles, uint32_t n, void* user_data) {
+    for (uint32_t i = 0; i < n; i++) {
+        ((PoolItem*)tc_pool_get(pool, handles[i]))->value = 9;
+    }
+    ((HookStats*)user_data)->constructed += (int)n;
+    ((HookStats*)user_data)->batches++;
+}
+
+static int test_pool_hooks(void) {
+    HookStats stats = {0, 0, 0, 0};
+    tc_pool pool;
+    tc_pool_desc desc;
+    memset(&desc, 0, sizeof(desc));
+    desc.item_size = sizeof(PoolItem);
+    desc.flags = TC_POOL_DENSE | TC_POOL_NO_ZERO;
+    desc.init = item_init;
+    desc.destroy = item_destroy;
+    desc.relocate = item_relocate;
+    desc.init_batch = items_init_batch;
+    desc.hook_user_data = &stats;
+    TEST_ASSERT(tc_pool_init_ex(&pool, &desc), "init");
+
+    tc_handle a = tc_pool_alloc(&pool);
+    TEST_ASSERT(((PoolItem*)tc_pool_get(&pool, a))->value == 7, "init hook ran");
+
+    tc_handle batch[10];
+    tc_pool_alloc_n(&pool, 10, batch);
+    TEST_ASSERT(stats.batches == 1 && stats.constructed == 11, "batch constructor used by alloc_n");
+    TEST_ASSERT(((PoolItem*)tc_pool_get(&pool, batch[3]))->value == 9, "batch init values");
+
+    tc_pool_free_slot(&pool, a);
+    TEST_ASSERT(stats.destroyed == 1, "destroy on free");
+    TEST_ASSERT(stats.relocated == 1, "dense swap-remove relocates");
+
+    tc_pool_free_n(&pool, batch, 4);
+    tc_pool_clear(&pool);
+    TEST_ASSERT(stats.destroyed == 11, "destroy on clear");
+
+    tc_pool_alloc_n(&pool, 3, batch);
+    tc_pool_free(&pool);
+    TEST_ASSERT(stats.destroyed == 14, "destroy on pool free");
+    TEST_ASSERT(stats.constructed == stats.destroyed, "balanced lifetimes");
+    return 0;
+}
+
+static int test_pool_alignment(void) {
+    uint32_t flags[4] = {0, TC_POOL_DENSE, TC_POOL_PAGED, TC_POOL_PAGED | TC_POOL_HUGE_PAGES};
+
+    for (int mode = 0; mode < 4; mode++) {
+        // One cache line per item
+        tc_pool pool;
+        tc_pool_desc desc;
+        memset(&desc, 0, sizeof(desc));
+        desc.item_size = sizeof(PoolItem);
+        desc.alignment = 64;
+        desc.flags = flags[mode];
+        desc.page_items = 16;
+        TEST_ASSERT(tc_pool_init_ex(&pool, &desc), "init aligned");
+        TEST_ASSERT(pool.item_stride == 64, "stride rounded up to alignment");
+
+        tc_handle handles[100];
+        TEST_ASSERT(tc_pool_alloc_n(&pool, 100, handles) == 100, "alloc across growth");
+        for (int i = 0; i < 100; i++) {
+            PoolItem* item = (PoolItem*)tc_pool_get(&pool, handles[i]);
+            TEST_ASSERT(((uintptr_t)item & 63) == 0, "item aligned");
+            item->value = i;
+        }
+        for (int i = 0; i < 100; i += 2) tc_pool_free_slot(&pool, handles[i]);
+        TEST_ASSERT(tc_pool_compact(&pool, NULL), "compact");
+
+        int sum = 0;
+        tc_pool_foreach(&pool, sum_values, &sum);
+        TEST_ASSERT(sum == 2500, "items survive moves");  // 1 + 3 + ... + 99
+        tc_pool_free(&pool);
+    }
+
+    // Explicit stride must be a multiple of alignment
+    tc_pool pool;
+    tc_pool_desc desc;
+    memset(&desc, 0, sizeof(desc));
+    desc.item_size = sizeof(PoolItem);
+    desc.alignment = 32;
+    desc.stride = 48;
+    TEST_ASSERT(!tc_pool_init_ex(&pool, &desc), "reject misaligned stride");
+    desc.alignment = 48;
+    desc.stride = 0;
+    TEST_ASSERT(!tc_pool_init_ex(&pool, &desc), "reject non power of two");
+    return 0;
+}
+
+int main(void) {
+    printf("=== tc_pool tests ===\n");
+
+    int result = 0;
+    result |= test_pool_basic();
+    result |= test_pool_dense();
+    result |= test_pool_paged();
+    result |= test_pool_batch();
+    result |= test_pool_parallel_foreach();
+    result |= test_pool_compact();
+    result |= test_pool_bitmap_iteration();
+    result |= test_pool_snapshot();
+    result |= test_pool_hooks();
+    result |= test_pool_alignment();
+
+    if (result == 0) {
+        printf("PASS\n");
+    } else {
+        printf("FAIL\n");
+    }
+    return result;
+}
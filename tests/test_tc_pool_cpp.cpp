@@ -0,0 +1,118 @@
+// Tests for the typed tc::Pool<T> wrapper
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <tcbase/tc_pool.hpp>
+
+#define TEST_ASSERT(cond, msg) \
+    do { \
+        if (!(cond)) { \
+            printf("FAIL: %s (line %d)\n", msg, __LINE__); \
+            return 1; \
+        } \
+    } while (0)
+
+struct Body {
+    float mass;
+    float velocity[3];
+};
+
+struct Named {
+    std::string name;
+    static int live;
+
+    Named() { live++; }
+    explicit Named(std::string n) : name(std::move(n)) { live++; }
+    Named(Named&& other) noexcept : name(std::move(other.name)) { live++; }
+    ~Named() { live--; }
+};
+
+int Named::live = 0;
+
+static int test_typed_pool_trivial() {
+    tc::Pool<Body> pool;
+
+    tc::PoolHandle<Body> a = pool.create();
+    tc::PoolHandle<Body> b = pool.create(Body{2.0f, {1.0f, 0.0f, 0.0f}});
+    TEST_ASSERT(pool.size() == 2, "size");
+    TEST_ASSERT(pool.get(a)->mass == 0.0f, "default item zeroed");
+    TEST_ASSERT(pool.get(b)->mass == 2.0f, "constructed from args");
+
+    // The same pool is visible through the C API
+    TEST_ASSERT(tc_pool_get(pool.c_pool(), b.raw) == pool.get(b), "C and C++ lookups agree");
+
+    TEST_ASSERT(pool.destroy(a), "destroy");
+    TEST_ASSERT(!pool.contains(a) && pool.get(a) == nullptr, "stale handle rejected");
+    return 0;
+}
+
+static int test_typed_pool_nontrivial() {
+    {
+        tc::Pool<Named> pool(TC_POOL_DENSE);
+        std::vector<tc::PoolHandle<Named>> handles;
+        for (int i = 0; i < 100; i++) {
+            handles.push_back(pool.create("item" + std::to_string(i)));
+        }
+        TEST_ASSERT(Named::live == 100, "constructed in place");
+
+        // Swap-remove relocates through the move constructor
+        for (int i = 0; i < 100; i += 2) pool.destroy(handles[i]);
+        TEST_ASSERT(Named::live == 50, "destroyed on free");
+        for (int i = 1; i < 100; i += 2) {
+            Named* item = pool.get(handles[i]);
+            TEST_ASSERT(item && item->name == "item" + std::to_string(i), "relocated item intact");
+        }
+
+        // C allocation runs the default-construct hook
+        tc_handle c_handle = tc_pool_alloc(pool.c_pool());
+        TEST_ASSERT(Named::live == 51, "init hook constructs for C callers");
+        TEST_ASSERT(pool.get(tc::PoolHandle<Named>(c_handle))->name.empty(), "default constructed");
+    }
+    TEST_ASSERT(Named::live == 0, "pool destructor destroys live items");
+    return 0;
+}
+
+static int test_typed_pool_iteration() {
+    uint32_t modes[3] = {0, TC_POOL_DENSE, TC_POOL_PAGED};
+    for (uint32_t flags : modes) {
+        tc::Pool<Body> pool(flags);
+        std::vector<tc::PoolHandle<Body>> handles;
+        for (int i = 0; i < 300; i++) {
+            handles.push_back(pool.create(Body{float(i), {0, 0, 0}}));
+        }
+        for (int i = 0; i < 300; i += 3) pool.destroy(handles[i]);
+
+        float sum = 0.0f;
+        uint32_t visited = 0;
+        for (auto it = pool.begin(); it != pool.end(); ++it) {
+            TEST_ASSERT(pool.get(it.handle()) == &*it, "iterator handle resolves to item");
+            visited++;
+        }
+        for (Body& body : pool) sum += body.mass;
+
+        float expected = 0.0f;
+        for (int i = 0; i < 300; i++) {
+            if (i % 3 != 0) expected += float(i);
+        }
+        TEST_ASSERT(visited == pool.size(), "range-for visits live items");
+        TEST_ASSERT(sum == expected, "range-for sum");
+    }
+    return 0;
+}
+
+int main() {
+    printf("=== tc::Pool tests ===\n");
+
+    int result = 0;
+    result |= test_typed_pool_trivial();
+    result |= test_typed_pool_nontrivial();
+    result |= test_typed_pool_iteration();
+
+    if (result == 0) {
+        printf("PASS\n");
+    } else {
+        printf("FAIL\n");
+    }
+    return result;
+}
@@ -0,0 +1,141 @@
+// Stress test for tc_pool_mt: producers allocate, consumers validate and free,
+// readers probe handles concurrently.
+#include <atomic>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <tcbase/tc_pool_mt.h>
+
+#define TEST_ASSERT(cond, msg) \
+    do { \
+        if (!(cond)) { \
+            printf("FAIL: %s (line %d)\n", msg, __LINE__); \
+            return 1; \
+        } \
+    } while (0)
+
+struct Item {
+    uint64_t tag;
+    uint64_t payload[3];
+};
+
+static int test_pool_mt_single_thread() {
+    tc_pool_mt* pool = tc_pool_mt_new(sizeof(Item), 64);
+    TEST_ASSERT(pool != nullptr, "create");
+
+    tc_handle a = tc_pool_mt_alloc(pool);
+    TEST_ASSERT(tc_pool_mt_is_valid(pool, a), "alloc valid");
+    TEST_ASSERT(tc_pool_mt_free_slot(pool, a), "free");
+    TEST_ASSERT(!tc_pool_mt_is_valid(pool, a), "stale handle rejected");
+    TEST_ASSERT(!tc_pool_mt_free_slot(pool, a), "double free rejected");
+
+    tc_handle b = tc_pool_mt_alloc(pool);
+    TEST_ASSERT(b.index == a.index && b.generation != a.generation, "slot reused with new generation");
+
+    std::vector<tc_handle> handles;
+    for (int i = 0; i < 63; i++) handles.push_back(tc_pool_mt_alloc(pool));
+    TEST_ASSERT(tc_pool_mt_count(pool) == 64, "filled to max capacity");
+    TEST_ASSERT(tc_handle_is_invalid(tc_pool_mt_alloc(pool)), "alloc past max capacity fails");
+
+    tc_pool_mt_free(pool);
+    return 0;
+}
+
+static int test_pool_mt_stress() {
+    const int producers = 4;
+    const int consumers = 4;
+    const int readers = 2;
+    const int per_producer = 50000;
+
+    tc_pool_mt* pool = tc_pool_mt_new(sizeof(Item), 0);
+    TEST_ASSERT(pool != nullptr, "create");
+
+    std::mutex queue_mutex;
+    std::deque<tc_handle> queue;
+    std::atomic<int> produced{0};
+    std::atomic<int> consumed{0};
+    std::atomic<int> errors{0};
+    std::atomic<bool> done{false};
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([&, p]() {
+            for (int i = 0; i < per_producer; i++) {
+                tc_handle h = tc_pool_mt_alloc(pool);
+                Item* item = static_cast<Item*>(tc_pool_mt_get(pool, h));
+                if (!item || item->tag != 0) {
+                    errors++;
+                    continue;
+                }
+                item->tag = (uint64_t(p + 1) << 32) | h.index;
+                {
+                    std::lock_guard<std::mutex> lock(queue_mutex);
+                    queue.push_back(h);
+                }
+                produced++;
+            }
+        });
+    }
+
+    for (int c = 0; c < consumers; c++) {
+        threads.emplace_back([&]() {
+            while (consumed.load() < producers * per_producer) {
+                tc_handle h;
+                {
+                    std::lock_guard<std::mutex> lock(queue_mutex);
+                    if (queue.empty()) continue;
+                    h = queue.front();
+                    queue.pop_front();
+                }
+                Item* item = static_cast<Item*>(tc_pool_mt_get(pool, h));
+                // A slot handed to two owners at once would show a foreign tag
+                if (!item || uint32_t(item->tag) != h.index) errors++;
+                if (!tc_pool_mt_free_slot(pool, h)) errors++;
+                if (tc_pool_mt_is_valid(pool, h)) errors++;
+                consumed++;
+            }
+        });
+    }
+
+    for (int r = 0; r < readers; r++) {
+        threads.emplace_back([&]() {
+            uint32_t index = 0;
+            while (!done.load()) {
+                tc_handle h;
+                h.index = index++ % 4096;
+                h.generation = 1;
+                tc_pool_mt_is_valid(pool, h);
+                tc_pool_mt_get(pool, h);
+            }
+        });
+    }
+
+    for (int i = 0; i < producers + consumers; i++) threads[i].join();
+    done = true;
+    for (size_t i = producers + consumers; i < threads.size(); i++) threads[i].join();
+
+    TEST_ASSERT(errors.load() == 0, "no double ownership or lost frees");
+    TEST_ASSERT(produced.load() == producers * per_producer, "all produced");
+    TEST_ASSERT(tc_pool_mt_count(pool) == 0, "pool empty after stress");
+
+    tc_pool_mt_free(pool);
+    return 0;
+}
+
+int main() {
+    printf("=== tc_pool_mt tests ===\n");
+
+    int result = 0;
+    result |= test_pool_mt_single_thread();
+    result |= test_pool_mt_stress();
+
+    if (result == 0) {
+        printf("PASS\n");
+    } else {
+        printf("FAIL\n");
+    }
+    return result;
+}
@@ -0,0 +1,206 @@
+// Tests for tc_resource_loader: priorities, de-duplication, wait, callbacks
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+
+#include <tcbase/tc_resource_loader.h>
+
+#define TEST_ASSERT(cond, msg) \
+    do { \
+        if (!(cond)) { \
+            printf("FAIL: %s (line %d)\n", msg, __LINE__); \
+            return 1; \
+        } \
+    } while (0)
+
+struct Resource {
+    int id;
+};
+
+static std::atomic<int> g_decoded{0};
+static std::atomic<int> g_destroyed{0};
+
+// Decoding blocks while the gate is closed so tests control ordering
+static std::mutex g_gate_mutex;
+static std::condition_variable g_gate_cv;
+static bool g_gate_open = true;
+static int g_started = 0;
+static std::vector<int> g_order;
+
+static void set_gate(bool open) {
+    {
+        std::lock_guard<std::mutex> lock(g_gate_mutex);
+        g_gate_open = open;
+    }
+    g_gate_cv.notify_all();
+}
+
+static void* decode_resource(const char* uuid, void* user_data) {
+    (void)user_data;
+    int id = 0;
+    sscanf(uuid, "res-%d", &id);
+    {
+        std::unique_lock<std::mutex> lock(g_gate_mutex);
+        g_started++;
+        g_gate_cv.notify_all();
+        g_gate_cv.wait(lock, []() { return g_gate_open; });
+        g_order.push_back(id);
+    }
+    g_decoded.fetch_add(1);
+    if (id < 0) return nullptr;
+    return new Resource{id};
+}
+
+static void destroy_resource(void* resource) {
+    delete static_cast<Resource*>(resource);
+    g_destroyed.fetch_add(1);
+}
+
+static void on_loaded(const char* uuid, void* resource, tc_load_state state, void* user_data) {
+    (void)uuid;
+    (void)resource;
+    if (state == TC_LOAD_READY) static_cast<int*>(user_data)[0]++;
+    else static_cast<int*>(user_data)[1]++;
+}
+
+static void reset() {
+    g_decoded = 0;
+    g_destroyed = 0;
+    g_order.clear();
+    g_started = 0;
+    set_gate(true);
+}
+
+static int test_loader_wait_and_dedup() {
+    reset();
+    tc_resource_loader* loader = tc_resource_loader_new(decode_resource, destroy_resource, nullptr, 2);
+    TEST_ASSERT(loader != nullptr, "create");
+
+    int counts[2] = {0, 0};
+    TEST_ASSERT(tc_resource_loader_request(loader, "res-1", 0, on_loaded, counts) != TC_LOAD_NONE, "request");
+    tc_resource_loader_request(loader, "res-1", 0, on_loaded, counts);
+    tc_resource_loader_request(loader, "res--1", 0, on_loaded, counts);
+
+    Resource* r = static_cast<Resource*>(tc_resource_loader_wait(loader, "res-1"));
+    TEST_ASSERT(r != nullptr && r->id == 1, "wait returns resource");
+    TEST_ASSERT(tc_resource_loader_wait(loader, "res--1") == nullptr, "failed decode");
+    TEST_ASSERT(tc_resource_loader_state(loader, "res--1") == TC_LOAD_FAILED, "failed state");
+    TEST_ASSERT(tc_resource_loader_get(loader, "res-1") == r, "get after load");
+    TEST_ASSERT(tc_resource_loader_pending(loader) == 0, "nothing pending");
+    TEST_ASSERT(g_decoded == 2, "same uuid decoded once");
+
+    TEST_ASSERT(counts[0] == 0, "callbacks wait for dispatch");
+    TEST_ASSERT(tc_resource_loader_dispatch(loader) == 3, "dispatch all");
+    TEST_ASSERT(counts[0] == 2 && counts[1] == 1, "callback states");
+
+    // Late requests on a completed entry complete at the next dispatch
+    TEST_ASSERT(tc_resource_loader_request(loader, "res-1", 0, on_loaded, counts) == TC_LOAD_READY, "ready");
+    TEST_ASSERT(tc_resource_loader_dispatch(loader) == 1 && counts[0] == 3, "late callback");
+
+    TEST_ASSERT(tc_resource_loader_remove(loader, "res-1"), "remove");
+    TEST_ASSERT(g_destroyed == 1, "removed resource destroyed");
+    TEST_ASSERT(tc_resource_loader_state(loader, "res-1") == TC_LOAD_NONE, "removed state");
+
+    tc_resource_loader_free(loader);
+    return 0;
+}
+
+static int test_loader_priority() {
+    reset();
+    tc_resource_loader* loader = tc_resource_loader_new(decode_resource, destroy_resource, nullptr, 1);
+    TEST_ASSERT(loader != nullptr, "create");
+
+    // Occupy the single worker, then queue behind it
+    set_gate(false);
+    tc_resource_loader_request(loader, "res-0", 0, nullptr, nullptr);
+    {
+        std::unique_lock<std::mutex> lock(g_gate_mutex);
+        g_gate_cv.wait(lock, []() { return g_started > 0; });
+    }
+
+    tc_resource_loader_request(loader, "res-1", 1, nullptr, nullptr);
+    tc_resource_loader_request(loader, "res-2", 5, nullptr, nullptr);
+    tc_resource_loader_request(loader, "res-3", 3, nullptr, nullptr);
+    tc_resource_loader_request(loader, "res-1", 10, nullptr, nullptr);   // Bump
+    tc_resource_loader_request(loader, "res-4", 0, nullptr, nullptr);
+    TEST_ASSERT(tc_resource_loader_remove(loader, "res-4"), "cancel queued");
+    TEST_ASSERT(tc_resource_loader_pending(loader) == 4, "pending count");
+    set_gate(true);
+
+    for (int i = 0; i < 4; i++) {
+        char key[16];
+        snprintf(key, sizeof(key), "res-%d", i);
+        TEST_ASSERT(tc_resource_loader_wait(loader, key) != nullptr, "wait");
+    }
+    TEST_ASSERT(g_decoded == 4, "cancelled request not decoded");
+    {
+        std::lock_guard<std::mutex> lock(g_gate_mutex);
+        int expected[] = {0, 1, 2, 3};
+        TEST_ASSERT(g_order.size() == 4 && memcmp(g_order.data(), expected, sizeof(expected)) == 0,
+                    "priority order");
+    }
+
+    tc_resource_loader_free(loader);
+    TEST_ASSERT(g_destroyed == 4, "free destroys loaded resources");
+    return 0;
+}
+
+static int test_loader_concurrent_requests() {
+    reset();
+    tc_resource_loader* loader = tc_resource_loader_new(decode_resource, destroy_resource, nullptr, 0);
+    TEST_ASSERT(loader != nullptr, "create");
+
+    constexpr int THREADS = 4;
+    constexpr int KEYS = 200;
+    std::atomic<int> bad{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; t++) {
+        threads.emplace_back([&, t]() {
+            char key[16];
+            for (int i = 0; i < KEYS; i++) {
+                int id = (i * 7 + t * 13) % KEYS;
+                snprintf(key, sizeof(key), "res-%d", id);
+                tc_resource_loader_request(loader, key, i % 3, nullptr, nullptr);
+                if (i % 5 == 0) {
+                    Resource* r = static_cast<Resource*>(tc_resource_loader_wait(loader, key));
+                    if (!r || r->id != id) bad.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (std::thread& t : threads) {
+        t.join();
+    }
+    TEST_ASSERT(bad == 0, "wait results");
+
+    char key[16];
+    for (int i = 0; i < KEYS; i++) {
+        snprintf(key, sizeof(key), "res-%d", i);
+        tc_resource_loader_wait(loader, key);
+    }
+    TEST_ASSERT(g_decoded == KEYS, "each uuid decoded once");
+
+    tc_resource_loader_free(loader);
+    TEST_ASSERT(g_destroyed == KEYS, "all destroyed");
+    return 0;
+}
+
+int main() {
+    printf("=== tc_resource_loader tests ===\n");
+
+    int result = 0;
+    result |= test_loader_wait_and_dedup();
+    result |= test_loader_priority();
+    result |= test_loader_concurrent_requests();
+
+    if (result == 0) {
+        printf("PASS\n");
+    } else {
+        printf("FAIL\n");
+    }
+    return result;
+}
@@ -0,0 +1,387 @@
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <tcbase/tc_resource_map.h>
+#include <tcbase/tc_uuid_index.h>
+#include <tcbase/tc_uuid_map.h>
+
+#define TEST_ASSERT(cond, msg) \
+    do { \
+        if (!(cond)) { \
+            printf("FAIL: %s (line %d)\n", msg, __LINE__); \
+            return 1; \
+        } \
+    } while (0)
+
+static int destroyed = 0;
+
+static void count_destroy(void* resource) {
+    (void)resource;
+    destroyed++;
+}
+
+static void make_uuid(char* out, int i) {
+    snprintf(out, 37, "%08x-0000-4000-8000-%012x", (unsigned)i * 2654435761u, (unsigned)i);
+}
+
+static int test_map_basic(void) {
+    static int values[1000];
+    char uuid[37];
+    destroyed = 0;
+
+    tc_resource_map* map = tc_resource_map_new(count_destroy);
+    TEST_ASSERT(map != NULL, "create");
+
+    for (int i = 0; i < 1000; i++) {
+        make_uuid(uuid, i);
+        TEST_ASSERT(tc_resource_map_add(map, uuid, &values[i]), "add");
+    }
+    make_uuid(uuid, 7);
+    TEST_ASSERT(!tc_resource_map_add(map, uuid, &values[0]), "duplicate rejected");
+    TEST_ASSERT(tc_resource_map_count(map) == 1000, "count");
+
+    for (int i = 0; i < 1000; i += 2) {
+        make_uuid(uuid, i);
+        TEST_ASSERT(tc_resource_map_remove(map, uuid), "remove");
+    }
+    TEST_ASSERT(destroyed == 500, "destructor on remove");
+
+    for (int i = 0; i < 1000; i++) {
+        make_uuid(uuid, i);
+        void* expected = (i % 2) ? &values[i] : NULL;
+        TEST_ASSERT(tc_resource_map_get(map, uuid) == expected, "get after churn");
+    }
+
+    tc_resource_map_free(map);
+    TEST_ASSERT(destroyed == 1000, "destructor on free");
+    return 0;
+}
+
+// Remove-heavy churn must not lengthen probes or lose entries
+static int test_map_churn(void) {
+    static int values[4096];
+    char uuid[37];
+
+    tc_resource_map* map = tc_resource_map_new(NULL);
+    for (int round = 0; round < 8; round++) {
+        for (int i = 0; i < 4096; i++) {
+            make_uuid(uuid, round * 4096 + i);
+            TEST_ASSERT(tc_resource_map_add(map, uuid, &values[i]), "add");
+        }
+        for (int i = 0; i < 4096; i++) {
+            if (i % 8 == 0) continue;
+            make_uuid(uuid, round * 4096 + i);
+            TEST_ASSERT(tc_resource_map_remove(map, uuid), "remove");
+        }
+    }
+    TEST_ASSERT(tc_resource_map_count(map) == 8 * 512, "survivors");
+
+    for (int round = 0; round < 8; round++) {
+        for (int i = 0; i < 4096; i++) {
+            make_uuid(uuid, round * 4096 + i);
+            void* expected = (i % 8 == 0) ? &values[i] : NULL;
+            TEST_ASSERT(tc_resource_map_get(map, uuid) == expected, "lookup after churn");
+        }
+    }
+
+    tc_resource_map_free(map);
+    return 0;
+}
+
+static int test_map_hashed(void) {
+    int a = 1, b = 2;
+    const char* key = "0b8f3c1e-2d4a-4f6b-9c7d-1e2f3a4b5c6d";
+    uint64_t hash = tc_resource_map_hash(key);
+
+    tc_resource_map* map = tc_resource_map_new(NULL);
+    TEST_ASSERT(tc_resource_map_add_hashed(map, key, hash, &a), "add hashed");
+    TEST_ASSERT(tc_resource_map_get(map, key) == &a, "plain get sees hashed add");
+    TEST_ASSERT(tc_resource_map_get_hashed(map, key, hash) == &a, "get hashed");
+    TEST_ASSERT(!tc_resource_map_add(map, key, &b), "duplicate across variants");
+    TEST_ASSERT(tc_resource_map_get_hashed(map, key, hash ^ 1) == NULL, "hash mismatch misses");
+    TEST_ASSERT(tc_resource_map_remove_hashed(map, key, hash), "remove hashed");
+    TEST_ASSERT(!tc_resource_map_contains_hashed(map, key, hash), "gone");
+    tc_resource_map_free(map);
+    return 0;
+}
+
+static int test_map_budget(void) {
+    static int values[64];
+    char uuid[37];
+    destroyed = 0;
+
+    tc_resource_map* map = tc_resource_map_new(count_destroy);
+    for (int i = 0; i < 64; i++) {
+        make_uuid(uuid, i);
+        tc_resource_map_add(map, uuid, &values[i]);
+        tc_resource_map_set_cost(map, uuid, 100);
+    }
+    TEST_ASSERT(tc_resource_map_total_cost(map) == 6400, "total cost");
+
+    // Hold entry 0, touch entry 1 so entry 2 becomes the oldest unreferenced
+    make_uuid(uuid, 0);
+    TEST_ASSERT(tc_resource_map_acquire(map, uuid) == &values[0], "acquire");
+    make_uuid(uuid, 1);
+    tc_resource_map_acquire(map, uuid);
+    TEST_ASSERT(tc_resource_map_release(map, uuid), "release");
+    TEST_ASSERT(!tc_resource_map_release(map, uuid), "release unheld");
+
+    tc_resource_map_set_budget(map, 6200);
+    TEST_ASSERT(destroyed == 2 && tc_resource_map_total_cost(map) == 6200, "evict to budget");
+    make_uuid(uuid, 2);
+    TEST_ASSERT(!tc_resource_map_contains(map, uuid), "oldest evicted");
+    make_uuid(uuid, 3);
+    TEST_ASSERT(!tc_resource_map_contains(map, uuid), "next oldest evicted");
+    make_uuid(uuid, 1);
+    TEST_ASSERT(tc_resource_map_contains(map, uuid), "recently released kept");
+
+    // Referenced entries survive any budget; LRU survives resizes
+    for (int i = 64; i < 128; i++) {
+        make_uuid(uuid, i);
+        tc_resource_map_add(map, uuid, NULL);
+    }
+    tc_resource_map_set_budget(map, 1);
+    make_uuid(uuid, 0);
+    TEST_ASSERT(tc_resource_map_get(map, uuid) == &values[0], "held entry kept");
+    TEST_ASSERT(tc_resource_map_total_cost(map) == 100, "only held cost left");
+    TEST_ASSERT(tc_resource_map_count(map) == 65, "zero-cost entries kept");
+
+    TEST_ASSERT(tc_resource_map_release(map, uuid), "release last");
+    TEST_ASSERT(!tc_resource_map_contains(map, uuid), "evicted on release");
+    TEST_ASSERT(destroyed == 64, "all costed entries destroyed");
+    tc_resource_map_free(map);
+
+    // A zero-cost entry older than a costed one is not evicted for it
+    static int plain, texture;
+    destroyed = 0;
+    map = tc_resource_map_new(count_destroy);
+    tc_resource_map_set_budget(map, 500);
+    make_uuid(uuid, 200);
+    tc_resource_map_add(map, uuid, &plain);
+    make_uuid(uuid, 201);
+    tc_resource_map_add(map, uuid, &texture);
+    tc_resource_map_set_cost(map, uuid, 1000);
+    TEST_ASSERT(!tc_resource_map_contains(map, uuid), "over-budget entry evicted");
+    make_uuid(uuid, 200);
+    TEST_ASSERT(tc_resource_map_get(map, uuid) == &plain, "older zero-cost entry kept");
+    TEST_ASSERT(destroyed == 1, "only the costed entry destroyed");
+
+    // Dropping the cost to zero takes an entry off the eviction list
+    tc_resource_map_set_cost(map, uuid, 300);
+    tc_resource_map_set_cost(map, uuid, 0);
+    make_uuid(uuid, 202);
+    tc_resource_map_add(map, uuid, &texture);
+    tc_resource_map_set_cost(map, uuid, 600);
+    make_uuid(uuid, 200);
+    TEST_ASSERT(tc_resource_map_contains(map, uuid) && destroyed == 2, "cost reset to zero kept");
+
+    tc_resource_map_free(map);
+    return 0;
+}
+
+typedef struct {
+    int expected[2048];
+    int count;
+    int next;
+    int out_of_order;
+} OrderCheck;
+
+static bool check_order(const char* uuid, void* resource, void* user_data) {
+    (void)uuid;
+    OrderCheck* check = (OrderCheck*)user_data;
+    int id = *(int*)resource;
+    if (check->next >= check->count || check->expected[check->next] != id) check->out_of_order++;
+    check->next++;
+    return true;
+}
+
+static int test_map_bulk(void) {
+    static char keys[2048][37];
+    static int values[2048];
+    const char* uuids[2048];
+    void* resources[2048];
+    for (int i = 0; i < 2048; i++) {
+        make_uuid(keys[i], i);
+        values[i] = i;
+        uuids[i] = keys[i];
+        resources[i] = &values[i];
+    }
+    uuids[1000] = keys[10];  // duplicate within the batch
+
+    tc_resource_map* map = tc_resource_map_new(NULL);
+    TEST_ASSERT(tc_resource_map_reserve(map, 2048), "reserve");
+    TEST_ASSERT(tc_resource_map_add_many(map, uuids, resources, 2048) == 2047, "bulk add skips duplicate");
+    TEST_ASSERT(tc_resource_map_get(map, keys[2047]) == &values[2047], "bulk entries found");
+
+    // Remove most entries, then add more so holes get squeezed out
+    static OrderCheck check;
+    check.count = 0;
+    for (int i = 0; i < 2048; i++) {
+        if (i == 1000) continue;
+        if (i % 4 != 0) {
+            tc_resource_map_remove(map, keys[i]);
+        } else {
+            check.expected[check.count++] = i;
+        }
+    }
+    for (int i = 1; i < 2048; i += 4) {
+        tc_resource_map_add(map, keys[i], &values[i]);
+        check.expected[check.count++] = i;
+    }
+
+    check.next = 0;
+    check.out_of_order = 0;
+    tc_resource_map_foreach(map, check_order, &check);
+    TEST_ASSERT(check.next == check.count && check.out_of_order == 0, "foreach in insertion order");
+    TEST_ASSERT((int)tc_resource_map_count(map) == check.count, "count");
+
+    tc_resource_map_free(map);
+    return 0;
+}
+
+static int test_uuid_parse(void) {
+    const char* text = "0B8F3C1E-2D4A-4F6B-9C7D-1E2F3A4B5C6D";
+    tc_uuid id;
+    TEST_ASSERT(tc_uuid_parse(text, &id), "parse hyphenated");
+    TEST_ASSERT(id.hi == 0x0b8f3c1e2d4a4f6bULL && id.lo == 0x9c7d1e2f3a4b5c6dULL, "parsed words");
+
+    char out[TC_UUID_STRING_SIZE];
+    tc_uuid_format(id, out);
+    TEST_ASSERT(strcmp(out, "0b8f3c1e-2d4a-4f6b-9c7d-1e2f3a4b5c6d") == 0, "format");
+
+    tc_uuid plain;
+    TEST_ASSERT(tc_uuid_parse("0b8f3c1e2d4a4f6b9c7d1e2f3a4b5c6d", &plain), "parse plain");
+    TEST_ASSERT(tc_uuid_eq(id, plain), "same uuid");
+
+    TEST_ASSERT(!tc_uuid_parse("0b8f3c1e-2d4a-4f6b-9c7d-1e2f3a4b5c6", &plain), "reject short");
+    TEST_ASSERT(!tc_uuid_parse("0b8f3c1e_2d4a-4f6b-9c7d-1e2f3a4b5c6d", &plain), "reject separator");
+    TEST_ASSERT(!tc_uuid_parse("0b8f3c1e-2d4a-4f6b-9c7d-1e2f3a4b5c6g", &plain), "reject digit");
+    return 0;
+}
+
+static int test_uuid_map(void) {
+    static int values[1000];
+    destroyed = 0;
+
+    tc_uuid_map* map = tc_uuid_map_new(count_destroy);
+    TEST_ASSERT(map != NULL, "create");
+
+    for (int i = 0; i < 1000; i++) {
+        tc_uuid id = {(uint64_t)i, (uint64_t)i * 31};
+        TEST_ASSERT(tc_uuid_map_add(map, id, &values[i]), "add");
+    }
+    tc_uuid dup = {7, 7 * 31};
+    TEST_ASSERT(!tc_uuid_map_add(map, dup, NULL), "duplicate rejected");
+
+    for (int i = 0; i < 1000; i += 2) {
+        tc_uuid id = {(uint64_t)i, (uint64_t)i * 31};
+        TEST_ASSERT(tc_uuid_map_remove(map, id), "remove");
+    }
+    for (int i = 0; i < 1000; i++) {
+        tc_uuid id = {(uint64_t)i, (uint64_t)i * 31};
+        void* expected = (i % 2) ? &values[i] : NULL;
+        TEST_ASSERT(tc_uuid_map_get(map, id) == expected, "get after churn");
+    }
+    TEST_ASSERT(tc_uuid_map_count(map) == 500, "count");
+
+    tc_uuid_map_free(map);
+    TEST_ASSERT(destroyed == 1000, "destructor on remove and free");
+    return 0;
+}
+
+static int load_calls = 0;
+
+static void* load_from_index(const char* uuid, uint64_t value, void* user_data) {
+    (void)uuid;
+    load_calls++;
+    return (int*)user_data + value;
+}
+
+static int test_uuid_index(void) {
+    static int values[100];
+    static int extra;
+    tc_uuid keys[100];
+    uint64_t offsets[100];
+    char uuid[37];
+    const char* path = "test_tc_uuid_index.bin";
+
+    for (int i = 0; i < 100; i++) {
+        make_uuid(uuid, i);
+        TEST_ASSERT(tc_uuid_parse(uuid, &keys[i]), "parse key");
+        offsets[i] = (uint64_t)i;
+    }
+    TEST_ASSERT(tc_uuid_index_write(path, keys, offsets, 100), "write index");
+
+    tc_uuid_index* index = tc_uuid_index_open(path);
+    TEST_ASSERT(index != NULL, "open index");
+    TEST_ASSERT(tc_uuid_index_count(index) == 100, "index count");
+
+    uint64_t value = 0;
+    TEST_ASSERT(tc_uuid_index_lookup(index, keys[42], &value) && value == 42, "index lookup");
+    tc_uuid missing = {1, 2};
+    TEST_ASSERT(!tc_uuid_index_lookup(index, missing, NULL), "index miss");
+
+    destroyed = 0;
+    load_calls = 0;
+    tc_layered_map* map = tc_layered_map_new(index, count_destroy, load_from_index, values);
+    TEST_ASSERT(map != NULL, "create layered");
+    TEST_ASSERT(tc_layered_map_count(map) == 100, "layered count");
+
+    make_uuid(uuid, 5);
+    TEST_ASSERT(tc_layered_map_contains(map, uuid) && load_calls == 0, "contains does not load");
+    TEST_ASSERT(tc_layered_map_get(map, uuid) == &values[5], "load from base");
+    TEST_ASSERT(tc_layered_map_get(map, uuid) == &values[5] && load_calls == 1, "loaded once");
+    TEST_ASSERT(!tc_layered_map_add(map, uuid, &extra), "base key is taken");
+
+    TEST_ASSERT(tc_layered_map_remove(map, uuid), "remove base key");
+    TEST_ASSERT(destroyed == 1, "loaded resource destroyed");
+    TEST_ASSERT(!tc_layered_map_contains(map, uuid), "removed key hidden");
+    TEST_ASSERT(tc_layered_map_get(map, uuid) == NULL, "removed key not reloaded");
+    TEST_ASSERT(tc_layered_map_count(map) == 99, "count after remove");
+    TEST_ASSERT(tc_layered_map_add(map, uuid, &extra), "re-add removed key");
+    TEST_ASSERT(tc_layered_map_get(map, uuid) == &extra, "re-added resource");
+
+    // Other spellings of a removed key stay hidden
+    make_uuid(uuid, 6);
+    TEST_ASSERT(tc_layered_map_remove(map, uuid), "remove lower case");
+    for (char* c = uuid; *c; c++) *c = (char)toupper((unsigned char)*c);
+    TEST_ASSERT(tc_layered_map_get(map, uuid) == NULL, "upper case not reloaded");
+    TEST_ASSERT(!tc_layered_map_contains(map, uuid), "upper case hidden");
+    TEST_ASSERT(!tc_layered_map_remove(map, uuid), "upper case already removed");
+    TEST_ASSERT(tc_layered_map_count(map) == 99, "count after case variants");
+    TEST_ASSERT(!tc_layered_map_add(map, "not-a-uuid", &extra), "unparsable key rejected");
+
+    make_uuid(uuid, 500);
+    TEST_ASSERT(tc_layered_map_add(map, uuid, &extra), "add new key");
+    TEST_ASSERT(tc_layered_map_count(map) == 100, "count after add");
+    TEST_ASSERT(tc_layered_map_remove(map, uuid), "remove new key");
+    TEST_ASSERT(tc_layered_map_count(map) == 99, "count after removing new key");
+
+    tc_layered_map_free(map);
+    TEST_ASSERT(destroyed == 3, "free destroys loaded resources");
+    tc_uuid_index_close(index);
+    remove(path);
+    return 0;
+}
+
+int main(void) {
+    printf("=== tc_resource_map tests ===\n");
+
+    int result = 0;
+    result |= test_map_basic();
+    result |= test_map_churn();
+    result |= test_map_hashed();
+    result |= test_map_budget();
+    result |= test_map_bulk();
+    result |= test_uuid_parse();
+    result |= test_uuid_map();
+    result |= test_uuid_index();
+
+    if (result == 0) {
+        printf("PASS\n");
+    } else {
+        printf("FAIL\n");
+    }
+    return result;
+}
@@ -0,0 +1,136 @@
+// Stress test for tc_resource_map_mt: readers resolve keys while a writer
+// keeps adding and removing entries.
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include <tcbase/tc_resource_map_mt.h>
+
+#define TEST_ASSERT(cond, msg) \
+    do { \
+        if (!(cond)) { \
+            printf("FAIL: %s (line %d)\n", msg, __LINE__); \
+            return 1; \
+        } \
+    } while (0)
+
+struct Resource {
+    int id;
+};
+
+static std::atomic<int> g_destroyed{0};
+
+static void destroy_resource(void* resource) {
+    delete static_cast<Resource*>(resource);
+    g_destroyed.fetch_add(1);
+}
+
+static void make_key(char* out, int i) {
+    snprintf(out, 37, "%08x-0000-4000-8000-%012x", (unsigned)i * 2654435761u, (unsigned)i);
+}
+
+static int test_map_mt_single_thread() {
+    char key[37];
+    g_destroyed = 0;
+
+    tc_resource_map_mt* map = tc_resource_map_mt_new(destroy_resource);
+    TEST_ASSERT(map != nullptr, "create");
+
+    for (int i = 0; i < 1000; i++) {
+        make_key(key, i);
+        TEST_ASSERT(tc_resource_map_mt_add(map, key, new Resource{i}), "add");
+    }
+    make_key(key, 5);
+    Resource dup{5};
+    TEST_ASSERT(!tc_resource_map_mt_add(map, key, &dup), "duplicate rejected");
+
+    for (int i = 0; i < 1000; i += 2) {
+        make_key(key, i);
+        TEST_ASSERT(tc_resource_map_mt_remove(map, key), "remove");
+    }
+    TEST_ASSERT(tc_resource_map_mt_count(map) == 500, "count");
+
+    for (int i = 0; i < 1000; i++) {
+        make_key(key, i);
+        Resource* r = static_cast<Resource*>(tc_resource_map_mt_get(map, key));
+        if (i % 2) {
+            TEST_ASSERT(r && r->id == i, "get");
+        } else {
+            TEST_ASSERT(r == nullptr, "removed");
+        }
+    }
+
+    tc_resource_map_mt_free(map);
+    TEST_ASSERT(g_destroyed == 1000, "destructor on remove and free");
+    return 0;
+}
+
+// Keys below STABLE never change; the writer churns the rest
+static int test_map_mt_concurrent() {
+    constexpr int STABLE = 512;
+    constexpr int CHURN = 4096;
+    constexpr int READERS = 4;
+
+    tc_resource_map_mt* map = tc_resource_map_mt_new(nullptr);
+    static Resource resources[STABLE + CHURN];
+    char key[37];
+    for (int i = 0; i < STABLE + CHURN; i++) resources[i].id = i;
+    for (int i = 0; i < STABLE; i++) {
+        make_key(key, i);
+        tc_resource_map_mt_add(map, key, &resources[i]);
+    }
+
+    std::atomic<bool> stop{false};
+    std::atomic<int> errors{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < READERS; t++) {
+        readers.emplace_back([&, t] {
+            char k[37];
+            unsigned i = (unsigned)t;
+            while (!stop.load(std::memory_order_relaxed)) {
+                i = i * 1103515245u + 12345u;
+                int id = (int)(i % (STABLE + CHURN));
+                make_key(k, id);
+                Resource* r = static_cast<Resource*>(tc_resource_map_mt_get(map, k));
+                if (id < STABLE ? (!r || r->id != id) : (r && r->id != id)) {
+                    errors.fetch_add(1);
+                }
+            }
+        });
+    }
+
+    for (int round = 0; round < 20; round++) {
+        for (int i = STABLE; i < STABLE + CHURN; i++) {
+            make_key(key, i);
+            tc_resource_map_mt_add(map, key, &resources[i]);
+        }
+        for (int i = STABLE; i < STABLE + CHURN; i++) {
+            make_key(key, i);
+            tc_resource_map_mt_remove(map, key);
+        }
+    }
+
+    stop = true;
+    for (std::thread& t : readers) t.join();
+
+    TEST_ASSERT(errors == 0, "readers saw consistent entries");
+    TEST_ASSERT(tc_resource_map_mt_count(map) == STABLE, "count after churn");
+    tc_resource_map_mt_free(map);
+    return 0;
+}
+
+int main() {
+    printf("=== tc_resource_map_mt tests ===\n");
+
+    int result = 0;
+    result |= test_map_mt_single_thread();
+    result |= test_map_mt_concurrent();
+
+    if (result == 0) {
+        printf("PASS\n");
+    } else {
+        printf("FAIL\n");
+    }
+    return result;
+}
@@ -0,0 +1,140 @@
+// Tests for tgfx_intern_string: identity, growth, concurrency and atoms
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <tcbase/tgfx_intern_string.hpp>
+
+#define TEST_ASSERT(cond, msg) \
+    do { \
+        if (!(cond)) { \
+            printf("FAIL: %s (line %d)\n", msg, __LINE__); \
+            return 1; \
+        } \
+    } while (0)
+
+static int test_intern_basic() {
+    const char* a = tgfx_intern_string("u_model");
+    std::string copy = "u_model";
+    TEST_ASSERT(a != nullptr && strcmp(a, "u_model") == 0, "interned copy");
+    TEST_ASSERT(tgfx_intern_string(copy.c_str()) == a, "same pointer");
+    TEST_ASSERT(tgfx_intern_string("u_view") != a, "distinct strings");
+    TEST_ASSERT(tgfx_intern_string("")[0] == '\0', "empty string");
+    TEST_ASSERT(tgfx_intern_string(nullptr) == nullptr, "null");
+
+    // Longer than an arena block
+    std::string big(100000, 'x');
+    const char* b = tgfx_intern_string(big.c_str());
+    TEST_ASSERT(b && strlen(b) == big.size(), "oversize string");
+    TEST_ASSERT(tgfx_intern_string("u_model") == a, "stable after oversize block");
+
+    // Force several table growths
+    std::vector<const char*> ptrs;
+    char name[32];
+    for (int i = 0; i < 20000; i++) {
+        snprintf(name, sizeof(name), "material_%d", i);
+        ptrs.push_back(tgfx_intern_string(name));
+    }
+    for (int i = 0; i < 20000; i++) {
+        snprintf(name, sizeof(name), "material_%d", i);
+        TEST_ASSERT(tgfx_intern_string(name) == ptrs[i], "stable after growth");
+    }
+    TEST_ASSERT(tgfx_intern_string("u_model") == a, "early string after growth");
+
+    tgfx_intern_cleanup();
+    return 0;
+}
+
+static int test_intern_concurrent() {
+    constexpr int THREADS = 4;
+    constexpr int NAMES = 5000;
+    std::vector<std::vector<const char*>> results(THREADS, std::vector<const char*>(NAMES));
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; t++) {
+        threads.emplace_back([&results, t]() {
+            char name[32];
+            for (int i = 0; i < NAMES; i++) {
+                // Each thread walks the names in a different order
+                int id = (i * 7919 + t * 1237) % NAMES;
+                snprintf(name, sizeof(name), "shader_%d", id);
+                results[t][id] = tgfx_intern_string(name);
+            }
+        });
+    }
+    for (std::thread& t : threads) {
+        t.join();
+    }
+
+    char name[32];
+    for (int i = 0; i < NAMES; i++) {
+        snprintf(name, sizeof(name), "shader_%d", i);
+        TEST_ASSERT(results[0][i] && strcmp(results[0][i], name) == 0, "content");
+        for (int t = 1; t < THREADS; t++) {
+            TEST_ASSERT(results[t][i] == results[0][i], "one copy per string");
+        }
+    }
+
+    tgfx_intern_cleanup();
+    return 0;
+}
+
+static_assert(tc::intern_hash("u_model") != tc::intern_hash("u_view"), "constexpr hash");
+
+static int test_atoms() {
+    tgfx_atom model = tc::atom("u_model");
+    TEST_ASSERT(model != TGFX_ATOM_NONE, "atom assigned");
+    TEST_ASSERT(tgfx_atom_intern("u_model") == model, "same atom at runtime");
+    TEST_ASSERT(tc::intern_atom(std::string("u_model")) == model, "same atom from std::string");
+    TEST_ASSERT(tgfx_intern_hash("u_model", 7) == tc::intern_hash("u_model"), "hash matches");
+
+    const char* s = tgfx_atom_string(model);
+    TEST_ASSERT(s && strcmp(s, "u_model") == 0, "reverse lookup");
+    TEST_ASSERT(s == tgfx_intern_string("u_model"), "atom string is the interned pointer");
+    TEST_ASSERT(tgfx_atom_of_interned(s) == model, "atom of interned pointer");
+    TEST_ASSERT(tgfx_atom_length(model) == 7, "length");
+    TEST_ASSERT(tc::atom_view(model) == "u_model", "view");
+
+    // Length-aware: a prefix of a larger buffer
+    const char buffer[] = "u_model_matrix";
+    TEST_ASSERT(tgfx_atom_intern_n(buffer, 7) == model, "prefix atom");
+    const char* matrix = tgfx_intern_string_n(buffer + 2, 5);
+    TEST_ASSERT(matrix && strcmp(matrix, "model") == 0, "interned slice is terminated");
+
+    // Dense ids, including across atom chunks
+    tgfx_atom first = tgfx_atom_count() + 1;
+    char name[32];
+    for (int i = 0; i < 5000; i++) {
+        snprintf(name, sizeof(name), "uniform_%d", i);
+        TEST_ASSERT(tgfx_atom_intern(name) == first + (tgfx_atom)i, "dense ids");
+    }
+    for (int i = 0; i < 5000; i++) {
+        snprintf(name, sizeof(name), "uniform_%d", i);
+        TEST_ASSERT(strcmp(tgfx_atom_string(first + (tgfx_atom)i), name) == 0, "reverse lookup after growth");
+    }
+    TEST_ASSERT(tgfx_atom_string(TGFX_ATOM_NONE) == nullptr, "none");
+    TEST_ASSERT(tgfx_atom_string(tgfx_atom_count() + 1) == nullptr, "unassigned");
+
+    tgfx_intern_cleanup();
+    TEST_ASSERT(tgfx_atom_count() == 0, "cleanup resets atoms");
+    return 0;
+}
+
+int main() {
+    printf("=== tgfx_intern_string tests ===\n");
+
+    int result = 0;
+    result |= test_intern_basic();
+    result |= test_intern_concurrent();
+    result |= test_atoms();
+
+    if (result == 0) {
+        printf("PASS\n");
+    } else {
+        printf("FAIL\n");
+    }
+    return result;
+}